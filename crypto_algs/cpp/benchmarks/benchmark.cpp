@@ -0,0 +1,682 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "des.hpp"
+#include "rsa.hpp"
+#include "key_cache.hpp"
+#include "pipeline.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_RDTSC 1
+#else
+#define BENCH_HAVE_RDTSC 0
+#endif
+
+// --- Benchmark Suite ---
+// Micro and macro benchmarks for the DES and RSA primitives:
+//   des-keys  key schedule setup (round keys, DesKeySchedule, TripleDesKeySchedule)
+//             and cache hits over 1024 interleaved keys
+//   des-block single-block latency (DES, 3DES)
+//   des-bulk  ECB / CBC / CTR over each buffer size on every available engine
+//   des-mt    parallel CTR and CBC decryption over each thread count
+//   rsa       mod_exp and RSA operations per second for each key size
+//   pipeline  small requests one call at a time versus batched through
+//             CryptoPipeline (DES messages under distinct keys, RSA decryption)
+//   timing    timing variance of the secret-dependent paths (fixed vs random
+//             inputs, Welch's t); not in the default set, run --only=timing
+// Each case is repeated until it has run for --min-time seconds; the best of
+// three repetitions is reported. Cycle counts come from the time-stamp
+// counter, which ticks at a fixed reference rate (not the boosted core
+// clock), so compare cycle figures on one machine only.
+//
+// Usage: benchmark [--format=text|json|csv] [--only=des-keys,des-bulk,...]
+//                  [--sizes=64,1K,64K,4M] [--threads=1,2,4] [--rsa-bits=1024,2048,4096]
+//                  [--min-time=0.2]
+
+struct BenchOptions {
+    std::string format = "text";
+    std::vector<std::string> groups = {"des-keys", "des-block", "des-bulk", "des-mt", "rsa", "pipeline"};
+    std::vector<size_t> sizes = {64, 1024, 64 * 1024, 4 * 1024 * 1024};
+    std::vector<size_t> threads;
+    std::vector<size_t> rsa_bits = {1024, 2048};
+    double min_time = 0.2;
+};
+
+struct BenchResult {
+    std::string group;
+    std::string name;
+    std::string engine;   // DES engine, empty for RSA
+    size_t bytes = 0;     // bytes processed per operation, 0 if not a throughput case
+    size_t threads = 1;
+    size_t key_bits = 0;
+    double ns_per_op = 0;
+    double cycles_per_op = 0; // 0 without a cycle counter
+    double welch_t = 0;       // timing group only
+};
+
+// --- Timing ---
+
+inline uint64_t read_cycles() {
+#if BENCH_HAVE_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Keeps results observable so the measured work is not optimized away
+inline volatile uint64_t bench_sink = 0;
+
+// Function to time op(): doubles the iteration count until one batch takes
+// min_time, then keeps the best per-iteration time of three batches
+template <typename Op>
+void measure(Op op, double min_time, BenchResult& result) {
+    using clock = std::chrono::steady_clock;
+    op(); // warm-up: caches, lazy engine detection, page faults
+    size_t iterations = 1;
+    double best_ns = 0, best_cycles = 0;
+    for (int repetition = 0; repetition < 3;) {
+        auto start = clock::now();
+        uint64_t start_cycles = read_cycles();
+        for (size_t i = 0; i < iterations; ++i) op();
+        uint64_t cycles = read_cycles() - start_cycles;
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        if (seconds < min_time && repetition == 0) {
+            iterations *= seconds > 0 ? std::max<size_t>(2, static_cast<size_t>(1.2 * min_time / seconds)) : 2;
+            continue;
+        }
+        double ns = seconds * 1e9 / iterations;
+        if (repetition == 0 || ns < best_ns) {
+            best_ns = ns;
+            best_cycles = static_cast<double>(cycles) / iterations;
+        }
+        ++repetition;
+    }
+    result.ns_per_op = best_ns;
+    result.cycles_per_op = BENCH_HAVE_RDTSC ? best_cycles : 0;
+}
+
+// --- DES Benchmarks ---
+
+const DesEngine ALL_ENGINES[] = {DesEngine::Scalar, DesEngine::Bitslice64, DesEngine::Bitslice128,
+                                 DesEngine::Bitslice256, DesEngine::Bitslice512};
+
+void bench_des_keys(const BenchOptions& options, std::vector<BenchResult>& results) {
+    uint64_t key = 0x133457799BBCDFF1ull;
+    auto add = [&](const char* name, auto op) {
+        BenchResult result{"des-keys", name, ""};
+        measure(op, options.min_time, result);
+        results.push_back(result);
+    };
+    add("generate_round_keys", [&] {
+        uint64_t round_keys[16];
+        generate_round_keys(key++, round_keys);
+        bench_sink = bench_sink + round_keys[15];
+    });
+    add("DesKeySchedule", [&] {
+        DesKeySchedule schedule(key++);
+        bench_sink = bench_sink + schedule.decrypt_keys[0];
+    });
+    add("TripleDesKeySchedule", [&] {
+        TripleDesKeySchedule schedule(key, key ^ 0x0F0F0F0F0F0F0F0Full, key + 1);
+        ++key;
+        bench_sink = bench_sink + schedule.k1.encrypt_keys[15];
+    });
+
+    // Tenant-style traffic: requests cycle through more keys than fit in L1
+    constexpr uint64_t CACHED_KEYS = 1024;
+    uint64_t tenant = 0;
+    add("cached_des_schedule", [&] {
+        bench_sink = bench_sink + cached_des_schedule(tenant++ % CACHED_KEYS)->decrypt_keys[0];
+    });
+    add("cached_tdes_schedule", [&] {
+        uint64_t k = tenant++ % CACHED_KEYS;
+        bench_sink = bench_sink + cached_tdes_schedule(k, ~k, k + 1)->k1.encrypt_keys[15];
+    });
+}
+
+void bench_des_block(const BenchOptions& options, std::vector<BenchResult>& results) {
+    const DesKeySchedule schedule(0x133457799BBCDFF1ull);
+    const TripleDesKeySchedule triple(0x0123456789ABCDEFull, 0x23456789ABCDEF01ull, 0x456789ABCDEF0123ull);
+    uint64_t block = 0x0123456789ABCDEFull;
+    auto add = [&](const char* name, auto op) {
+        BenchResult result{"des-block", name, "scalar", 8};
+        measure(op, options.min_time, result);
+        results.push_back(result);
+    };
+    // Each block depends on the last, so this is latency rather than throughput
+    add("des_encrypt", [&] { block = des_encrypt(block, schedule); bench_sink = block; });
+    add("des_decrypt", [&] { block = des_decrypt(block, schedule); bench_sink = block; });
+    add("tdes_encrypt", [&] { block = tdes_encrypt(block, triple); bench_sink = block; });
+}
+
+void bench_des_bulk(const BenchOptions& options, std::vector<BenchResult>& results) {
+    const DesKeySchedule schedule(0x133457799BBCDFF1ull);
+    const TripleDesKeySchedule triple(0x0123456789ABCDEFull, 0x23456789ABCDEF01ull, 0x456789ABCDEF0123ull);
+    size_t max_size = *std::max_element(options.sizes.begin(), options.sizes.end());
+    std::vector<uint8_t> buffer(max_size);
+    thread_mersenne_twister().fill(buffer.data(), buffer.size());
+    uint8_t iv[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    DesEngine automatic = des_engine_info().engine;
+    for (DesEngine engine : ALL_ENGINES) {
+        if (!des_set_engine(engine)) continue;
+        const char* engine_name = des_engine_info().name;
+        for (size_t size : options.sizes) {
+            size_t nblocks = size / 8;
+            if (nblocks == 0) continue;
+            uint8_t* data = buffer.data();
+            auto add = [&](const char* name, auto op) {
+                BenchResult result{"des-bulk", name, engine_name, nblocks * 8};
+                measure(op, options.min_time, result);
+                results.push_back(result);
+            };
+            add("des_ecb_encrypt", [&] { des_encrypt_blocks(data, data, nblocks, schedule, Mode::ECB); });
+            add("des_cbc_encrypt", [&] { des_encrypt_blocks(data, data, nblocks, schedule, Mode::CBC, iv); });
+            add("des_cbc_decrypt", [&] { des_decrypt_blocks(data, data, nblocks, schedule, Mode::CBC, iv); });
+            add("des_ctr", [&] { des_encrypt_blocks(data, data, nblocks, schedule, Mode::CTR, iv); });
+            add("tdes_ctr", [&] { tdes_encrypt_blocks(data, data, nblocks, triple, Mode::CTR, iv); });
+        }
+    }
+    des_set_engine(automatic);
+}
+
+void bench_des_parallel(const BenchOptions& options, std::vector<BenchResult>& results) {
+    const DesKeySchedule schedule(0x133457799BBCDFF1ull);
+    size_t size = *std::max_element(options.sizes.begin(), options.sizes.end());
+    size_t nblocks = size / 8;
+    if (nblocks == 0) return;
+    std::vector<uint8_t> buffer(nblocks * 8);
+    thread_mersenne_twister().fill(buffer.data(), buffer.size());
+    uint8_t iv[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    const char* engine_name = des_engine_info().name;
+
+    for (size_t threads : options.threads) {
+        unsigned thread_count = static_cast<unsigned>(threads);
+        uint8_t* data = buffer.data();
+        auto add = [&](const char* name, auto op) {
+            BenchResult result{"des-mt", name, engine_name, nblocks * 8, threads};
+            measure(op, options.min_time, result);
+            results.push_back(result);
+        };
+        add("des_ctr_parallel", [&] { des_ctr_parallel(data, data, nblocks, schedule, iv, thread_count); });
+        add("des_cbc_decrypt_parallel",
+            [&] { des_cbc_decrypt_parallel(data, data, nblocks, schedule, iv, thread_count); });
+    }
+}
+
+// --- RSA Benchmarks ---
+
+// Batch width for the public-key batch path (a multiple of the IFMA lanes)
+constexpr size_t RSA_BATCH = 64;
+
+template <size_t Bits>
+void bench_rsa(const BenchOptions& options, std::vector<BenchResult>& results) {
+    auto add = [&](const char* name, auto op) {
+        BenchResult result{"rsa", name, "", 0, 1, Bits};
+        measure(op, options.min_time, result);
+        results.push_back(result);
+    };
+
+    // Key generation is slow at 4096 bits: one key per batch, best of three
+    {
+        BenchResult result{"rsa", "generate_keypair", "", 0, 1, Bits};
+        measure([] { bench_sink = bench_sink + generate_keypair<Bits>(Bits, 1).n.limbs[0]; }, 0, result);
+        results.push_back(result);
+    }
+
+    const RsaPrivateKey<Bits> key = generate_keypair<Bits>();
+    const RsaPublicKey<Bits> public_key = key.public_key();
+    std::vector<BigInt<Bits>> messages(RSA_BATCH), outputs(RSA_BATCH);
+    for (BigInt<Bits>& message : messages) message = random_bits<Bits>(Bits - 1);
+    const BigInt<Bits> ciphertext = mod_exp_vartime(messages[0], key.e, public_key.n_ctx);
+
+    add("montgomery_context", [&] { bench_sink = bench_sink + MontgomeryContext<Bits>(key.n).n_prime; });
+    add("cached_montgomery_context", [&] { bench_sink = bench_sink + cached_montgomery_context(key.n)->n_prime; });
+    add("public_mod_exp", [&] { bench_sink = bench_sink + mod_exp_vartime(messages[0], key.e, public_key.n_ctx).limbs[0]; });
+    {
+        BenchResult result{"rsa", "public_batch_per_op", "", 0, 1, Bits};
+        measure([&] { rsa_public_batch(messages.data(), outputs.data(), RSA_BATCH, public_key); },
+                options.min_time, result);
+        result.ns_per_op /= RSA_BATCH;
+        result.cycles_per_op /= RSA_BATCH;
+        results.push_back(result);
+    }
+    add("private_mod_exp", [&] { bench_sink = bench_sink + mod_exp(ciphertext, key.d, public_key.n_ctx).limbs[0]; });
+    add("private_crt", [&] { bench_sink = bench_sink + rsa_decrypt_crt(ciphertext, key).limbs[0]; });
+    {
+        BenchResult result{"rsa", "private_crt_parallel", "", 0, 2, Bits};
+        measure([&] { bench_sink = bench_sink + rsa_decrypt_crt(ciphertext, key, true).limbs[0]; },
+                options.min_time, result);
+        results.push_back(result);
+    }
+}
+
+void bench_rsa_sizes(const BenchOptions& options, std::vector<BenchResult>& results) {
+    for (size_t bits : options.rsa_bits) {
+        switch (bits) {
+        case 1024: bench_rsa<1024>(options, results); break;
+        case 2048: bench_rsa<2048>(options, results); break;
+        case 3072: bench_rsa<3072>(options, results); break;
+        case 4096: bench_rsa<4096>(options, results); break;
+        default: throw std::invalid_argument("unsupported RSA key size: " + std::to_string(bits));
+        }
+    }
+}
+
+// --- Request Pipeline ---
+// Gateway-style traffic: many short messages, each under its own session
+// key, and RSA decryptions under one server key. Each case is reported per
+// request, so the one-call and pipelined rows compare directly.
+
+constexpr size_t PIPELINE_MESSAGES = 512;
+constexpr size_t PIPELINE_MESSAGE_BYTES = 64;
+
+// Adds a case timed over requests requests, reported per request
+template <typename Op>
+void add_pipeline_case(const BenchOptions& options, std::vector<BenchResult>& results, BenchResult result,
+                       size_t requests, Op op) {
+    measure(op, options.min_time, result);
+    result.ns_per_op /= requests;
+    result.cycles_per_op /= requests;
+    results.push_back(result);
+}
+
+void bench_pipeline_des(const BenchOptions& options, std::vector<BenchResult>& results) {
+    using Pipeline = CryptoPipeline<1024>;
+    std::vector<Pipeline::DesKey> keys;
+    std::vector<Pipeline::TripleDesKey> triple_keys;
+    std::vector<Pipeline::Bytes> messages(PIPELINE_MESSAGES);
+    MersenneTwister& random = thread_mersenne_twister();
+    for (Pipeline::Bytes& message : messages) {
+        keys.push_back(std::make_shared<const DesKeySchedule>(random.next_u64()));
+        triple_keys.push_back(
+            std::make_shared<const TripleDesKeySchedule>(random.next_u64(), random.next_u64(), random.next_u64()));
+        message.resize(PIPELINE_MESSAGE_BYTES);
+        random.fill(message.data(), message.size());
+    }
+    const Pipeline::Iv iv = {1, 2, 3, 4, 5, 6, 7, 8};
+    const char* engine_name = des_engine_info().name;
+
+    add_pipeline_case(options, results, {"pipeline", "des_cbc_decrypt one call each", engine_name, PIPELINE_MESSAGE_BYTES},
+                      PIPELINE_MESSAGES, [&] {
+        for (size_t i = 0; i < PIPELINE_MESSAGES; ++i) {
+            Pipeline::Iv chain = iv;
+            des_decrypt_blocks(messages[i].data(), messages[i].data(), PIPELINE_MESSAGE_BYTES / 8, *keys[i],
+                               Mode::CBC, chain.data());
+        }
+    });
+    add_pipeline_case(options, results, {"pipeline", "tdes_cbc_decrypt one call each", engine_name, PIPELINE_MESSAGE_BYTES},
+                      PIPELINE_MESSAGES, [&] {
+        for (size_t i = 0; i < PIPELINE_MESSAGES; ++i) {
+            Pipeline::Iv chain = iv;
+            tdes_decrypt_blocks(messages[i].data(), messages[i].data(), PIPELINE_MESSAGE_BYTES / 8, *triple_keys[i],
+                                Mode::CBC, chain.data());
+        }
+    });
+
+    Pipeline pipeline;
+    std::vector<std::future<Pipeline::Bytes>> pending(PIPELINE_MESSAGES);
+    auto wait_all = [&] {
+        for (std::future<Pipeline::Bytes>& result : pending) bench_sink = bench_sink + result.get()[0];
+    };
+    add_pipeline_case(options, results, {"pipeline", "des_cbc_decrypt pipelined", engine_name, PIPELINE_MESSAGE_BYTES},
+                      PIPELINE_MESSAGES, [&] {
+        for (size_t i = 0; i < PIPELINE_MESSAGES; ++i) {
+            pending[i] = pipeline.des_decrypt(messages[i], keys[i], Mode::CBC, iv);
+        }
+        wait_all();
+    });
+    add_pipeline_case(options, results, {"pipeline", "tdes_cbc_decrypt pipelined", engine_name, PIPELINE_MESSAGE_BYTES},
+                      PIPELINE_MESSAGES, [&] {
+        for (size_t i = 0; i < PIPELINE_MESSAGES; ++i) {
+            pending[i] = pipeline.tdes_decrypt(messages[i], triple_keys[i], Mode::CBC, iv);
+        }
+        wait_all();
+    });
+}
+
+template <size_t Bits>
+void bench_pipeline_rsa(const BenchOptions& options, std::vector<BenchResult>& results) {
+    auto key = std::make_shared<const RsaPrivateKey<Bits>>(generate_keypair<Bits>());
+    const RsaPublicKey<Bits> public_key = key->public_key();
+    std::vector<BigInt<Bits>> ciphertexts(RSA_BATCH), outputs(RSA_BATCH);
+    for (BigInt<Bits>& c : ciphertexts) c = mod_exp_vartime(random_bits<Bits>(Bits - 1), key->e, public_key.n_ctx);
+    auto add = [&](const char* name, size_t requests, auto op) {
+        add_pipeline_case(options, results, {"pipeline", name, "", 0, 1, Bits}, requests, op);
+    };
+
+    add("rsa_decrypt_crt one call each", RSA_BATCH, [&] {
+        for (size_t i = 0; i < RSA_BATCH; ++i) outputs[i] = rsa_decrypt_crt(ciphertexts[i], *key);
+    });
+    add("rsa_decrypt_crt_batch", RSA_BATCH,
+        [&] { rsa_decrypt_crt_batch(ciphertexts.data(), outputs.data(), RSA_BATCH, *key); });
+    CryptoPipeline<Bits> pipeline;
+    std::vector<std::future<BigInt<Bits>>> pending(RSA_BATCH);
+    add("rsa_decrypt pipelined", RSA_BATCH, [&] {
+        for (size_t i = 0; i < RSA_BATCH; ++i) pending[i] = pipeline.rsa_decrypt(ciphertexts[i], key);
+        for (std::future<BigInt<Bits>>& result : pending) bench_sink = bench_sink + result.get().limbs[0];
+    });
+    // With nothing to batch with, a request waits out max_delay
+    add("rsa_decrypt lone request", 1,
+        [&] { bench_sink = bench_sink + pipeline.rsa_decrypt(ciphertexts[0], key).get().limbs[0]; });
+}
+
+void bench_pipeline(const BenchOptions& options, std::vector<BenchResult>& results) {
+    bench_pipeline_des(options, results);
+    for (size_t bits : options.rsa_bits) {
+        switch (bits) {
+        case 1024: bench_pipeline_rsa<1024>(options, results); break;
+        case 2048: bench_pipeline_rsa<2048>(options, results); break;
+        case 3072: bench_pipeline_rsa<3072>(options, results); break;
+        case 4096: bench_pipeline_rsa<4096>(options, results); break;
+        default: throw std::invalid_argument("unsupported RSA key size: " + std::to_string(bits));
+        }
+    }
+}
+
+// --- Timing Variance ---
+// Fixed-vs-random test in the style of dudect: each sample draws one of two
+// input classes at random, a fixed input or a fresh random one, and times a
+// single operation. Welch's t over the two classes then says whether the
+// running time depends on the data; |t| beyond about 4.5 is a leak. The
+// slowest 1% of samples (interrupts, migrations) are dropped first. Built
+// with CRYPTOALGS_CONSTANT_TIME the private-key cases should stay below it.
+
+constexpr size_t DES_TIMING_SAMPLES = 200000;
+constexpr size_t RSA_TIMING_SAMPLES = 2000;
+
+// Function to time op() once per sample after prepare(random_class) set up
+// its input; the reported time is the mean over both classes
+template <typename Prepare, typename Op>
+void measure_variance(size_t samples, Prepare prepare, Op op, BenchResult& result) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> times(samples);
+    std::vector<uint8_t> classes(samples);
+    MersenneTwister& generator = thread_mersenne_twister();
+    prepare(false);
+    op(); // warm-up
+    for (size_t i = 0; i < samples; ++i) {
+        classes[i] = generator() & 1;
+        prepare(classes[i] != 0);
+        auto start = clock::now();
+        uint64_t start_cycles = read_cycles();
+        op();
+        uint64_t cycles = read_cycles() - start_cycles;
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        times[i] = BENCH_HAVE_RDTSC ? static_cast<double>(cycles) : ns;
+        result.ns_per_op += ns;
+    }
+
+    std::vector<double> sorted = times;
+    std::nth_element(sorted.begin(), sorted.begin() + samples * 99 / 100, sorted.end());
+    double cutoff = sorted[samples * 99 / 100];
+    double count[2] = {}, sum[2] = {}, sum_squares[2] = {};
+    for (size_t i = 0; i < samples; ++i) {
+        if (times[i] > cutoff) continue;
+        count[classes[i]] += 1;
+        sum[classes[i]] += times[i];
+        sum_squares[classes[i]] += times[i] * times[i];
+    }
+    double mean[2], variance[2];
+    for (int c = 0; c < 2; ++c) {
+        mean[c] = sum[c] / count[c];
+        variance[c] = (sum_squares[c] - count[c] * mean[c] * mean[c]) / (count[c] - 1);
+    }
+    double spread = std::sqrt(variance[0] / count[0] + variance[1] / count[1]);
+    result.welch_t = spread > 0 ? (mean[0] - mean[1]) / spread : 0;
+    result.ns_per_op /= samples;
+    result.cycles_per_op = BENCH_HAVE_RDTSC ? (sum[0] + sum[1]) / (count[0] + count[1]) : 0;
+}
+
+void bench_des_timing(std::vector<BenchResult>& results) {
+    MersenneTwister& generator = thread_mersenne_twister();
+    const uint64_t fixed_key = 0x133457799BBCDFF1ull;
+    const uint64_t fixed_block = 0x0123456789ABCDEFull;
+    const DesKeySchedule schedule(fixed_key);
+    const TripleDesKeySchedule triple(0x0123456789ABCDEFull, 0x23456789ABCDEF01ull, 0x456789ABCDEF0123ull);
+    uint64_t key = fixed_key, block = fixed_block;
+    auto random_word = [&] { return (static_cast<uint64_t>(generator()) << 32) | generator(); };
+    auto add = [&](const char* name, auto prepare, auto op) {
+        BenchResult result{"timing", name, "", 0, 1, 0};
+        measure_variance(DES_TIMING_SAMPLES, prepare, op, result);
+        results.push_back(result);
+    };
+    auto random_block = [&](bool random) { block = random ? random_word() : fixed_block; };
+    add("des_encrypt block", random_block, [&] { bench_sink = des_encrypt(block, schedule); });
+    add("tdes_encrypt block", random_block, [&] { bench_sink = tdes_encrypt(block, triple); });
+    add("des key schedule", [&](bool random) { key = random ? random_word() : fixed_key; }, [&] {
+        uint64_t round_keys[16];
+        generate_round_keys(key, round_keys);
+        bench_sink = round_keys[15];
+    });
+}
+
+template <size_t Bits>
+void bench_rsa_timing(std::vector<BenchResult>& results) {
+    const RsaPrivateKey<Bits> key = generate_keypair<Bits>();
+    const RsaPublicKey<Bits> public_key = key.public_key();
+    auto add = [&](const char* name, auto prepare, auto op) {
+        BenchResult result{"timing", name, "", 0, 1, Bits};
+        measure_variance(RSA_TIMING_SAMPLES, prepare, op, result);
+        results.push_back(result);
+    };
+
+    // Exponent classes: the sparsest exponent as long as d, or a random one as long as d
+    size_t bits = key.d.bit_length();
+    BigInt<Bits> sparse = (BigInt<Bits>(1) << (bits - 1)) + BigInt<Bits>(1);
+    BigInt<Bits> exponent = sparse;
+    const BigInt<Bits> base = random_bits<Bits>(Bits - 1) % key.n;
+    add("mod_exp exponent", [&](bool random) {
+        if (!random) {
+            exponent = sparse;
+            return;
+        }
+        exponent = random_bits<Bits>(bits);
+        exponent.limbs[(bits - 1) / 64] |= uint64_t(1) << ((bits - 1) % 64);
+    }, [&] { bench_sink = mod_exp(base, exponent, public_key.n_ctx).limbs[0]; });
+
+    // Ciphertext classes: a tiny fixed value (shortcuts in the reductions), or a random one
+    BigInt<Bits> ciphertext = 2;
+    add("rsa_decrypt_crt ciphertext", [&](bool random) {
+        ciphertext = random ? random_bits<Bits>(Bits - 1) % key.n : BigInt<Bits>(2);
+    }, [&] { bench_sink = rsa_decrypt_crt(ciphertext, key).limbs[0]; });
+}
+
+void bench_timing(const BenchOptions& options, std::vector<BenchResult>& results) {
+    bench_des_timing(results);
+    for (size_t bits : options.rsa_bits) {
+        switch (bits) {
+        case 1024: bench_rsa_timing<1024>(results); break;
+        case 2048: bench_rsa_timing<2048>(results); break;
+        case 3072: bench_rsa_timing<3072>(results); break;
+        case 4096: bench_rsa_timing<4096>(results); break;
+        default: throw std::invalid_argument("unsupported RSA key size: " + std::to_string(bits));
+        }
+    }
+}
+
+// --- Output ---
+
+std::string format_number(double value) {
+    std::ostringstream out;
+    out.precision(value >= 100 ? 1 : 3);
+    out << std::fixed << value;
+    return out.str();
+}
+
+void write_text(const std::vector<BenchResult>& results, std::ostream& out) {
+    std::string group;
+    for (const BenchResult& r : results) {
+        if (r.group != group) {
+            group = r.group;
+            out << "\n[" << group << "]\n";
+        }
+        std::string label = r.name;
+        if (!r.engine.empty()) label += " (" + r.engine + ")";
+        if (r.bytes > 0 && r.group != "des-block") label += " " + std::to_string(r.bytes) + " B";
+        if (r.threads > 1 || r.group == "des-mt") label += " x" + std::to_string(r.threads);
+        if (r.key_bits > 0) label += " " + std::to_string(r.key_bits) + "-bit";
+        out << "  " << label << std::string(label.size() < 52 ? 52 - label.size() : 1, ' ');
+        out << format_number(r.ns_per_op) << " ns/op";
+        if (r.group == "timing") {
+            out << "  |t| " << format_number(std::fabs(r.welch_t));
+            if (r.cycles_per_op > 0) out << "  " << format_number(r.cycles_per_op) << " cycles/op";
+        } else if (r.bytes > 0) {
+            out << "  " << format_number(r.bytes / r.ns_per_op * 1e3) << " MB/s";
+            if (r.cycles_per_op > 0) out << "  " << format_number(r.cycles_per_op / r.bytes) << " cycles/B";
+        } else {
+            out << "  " << format_number(1e9 / r.ns_per_op) << " ops/s";
+            if (r.cycles_per_op > 0) out << "  " << format_number(r.cycles_per_op) << " cycles/op";
+        }
+        out << "\n";
+    }
+}
+
+const char* CSV_HEADER = "group,name,engine,bytes,threads,key_bits,ns_per_op,ops_per_sec,"
+                         "mb_per_sec,cycles_per_op,cycles_per_byte,welch_t";
+
+void write_csv(const std::vector<BenchResult>& results, std::ostream& out) {
+    out << CSV_HEADER << "\n";
+    for (const BenchResult& r : results) {
+        out << r.group << ',' << r.name << ',' << r.engine << ',' << r.bytes << ',' << r.threads << ','
+            << r.key_bits << ',' << r.ns_per_op << ',' << 1e9 / r.ns_per_op << ',';
+        if (r.bytes > 0) out << r.bytes / r.ns_per_op * 1e3;
+        out << ',';
+        if (r.cycles_per_op > 0) out << r.cycles_per_op;
+        out << ',';
+        if (r.cycles_per_op > 0 && r.bytes > 0) out << r.cycles_per_op / r.bytes;
+        out << ',';
+        if (r.group == "timing") out << r.welch_t;
+        out << "\n";
+    }
+}
+
+void write_json(const std::vector<BenchResult>& results, std::ostream& out) {
+    auto optional = [](bool present, double value) { return present ? std::to_string(value) : std::string("null"); };
+    out << "{\n  \"cycle_counter\": \"" << (BENCH_HAVE_RDTSC ? "rdtsc" : "none") << "\",\n";
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"des_engine\": \"" << des_engine_info().name << "\",\n";
+    out << "  \"constant_time\": " << (CRYPTOALGS_CONSTANT_TIME ? "true" : "false") << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name
+            << "\", \"engine\": \"" << r.engine << "\", \"bytes\": " << r.bytes << ", \"threads\": " << r.threads
+            << ", \"key_bits\": " << r.key_bits << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"ops_per_sec\": " << 1e9 / r.ns_per_op
+            << ", \"mb_per_sec\": " << optional(r.bytes > 0, r.bytes / r.ns_per_op * 1e3)
+            << ", \"cycles_per_op\": " << optional(r.cycles_per_op > 0, r.cycles_per_op)
+            << ", \"cycles_per_byte\": " << optional(r.cycles_per_op > 0 && r.bytes > 0, r.cycles_per_op / r.bytes)
+            << ", \"welch_t\": " << optional(r.group == "timing", r.welch_t)
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// --- Command Line ---
+
+std::vector<std::string> split_list(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    for (std::string item; std::getline(stream, item, ',');) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Function to parse a size with an optional K or M suffix (powers of 1024)
+size_t parse_size(const std::string& text) {
+    size_t consumed = 0;
+    size_t value = std::stoull(text, &consumed);
+    std::string suffix = text.substr(consumed);
+    if (suffix == "K" || suffix == "k") return value << 10;
+    if (suffix == "M" || suffix == "m") return value << 20;
+    if (!suffix.empty()) throw std::invalid_argument("bad size: " + text);
+    return value;
+}
+
+std::vector<size_t> parse_sizes(const std::string& list) {
+    std::vector<size_t> values;
+    for (const std::string& item : split_list(list)) values.push_back(parse_size(item));
+    if (values.empty()) throw std::invalid_argument("empty list: " + list);
+    return values;
+}
+
+BenchOptions parse_options(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string flag = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (flag == "--format") options.format = value;
+        else if (flag == "--only") options.groups = split_list(value);
+        else if (flag == "--sizes") options.sizes = parse_sizes(value);
+        else if (flag == "--threads") options.threads = parse_sizes(value);
+        else if (flag == "--rsa-bits") options.rsa_bits = parse_sizes(value);
+        else if (flag == "--min-time") options.min_time = std::stod(value);
+        else throw std::invalid_argument("unknown option: " + arg);
+    }
+    if (options.format != "text" && options.format != "json" && options.format != "csv") {
+        throw std::invalid_argument("unknown format: " + options.format);
+    }
+    // Default thread counts: powers of two up to the core count, then the core count
+    if (options.threads.empty()) {
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t t = 1; t < cores; t *= 2) options.threads.push_back(t);
+        options.threads.push_back(cores);
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 2;
+    }
+    auto wanted = [&](const char* group) {
+        return std::find(options.groups.begin(), options.groups.end(), group) != options.groups.end();
+    };
+
+    std::vector<BenchResult> results;
+    try {
+        if (wanted("des-keys")) bench_des_keys(options, results);
+        if (wanted("des-block")) bench_des_block(options, results);
+        if (wanted("des-bulk")) bench_des_bulk(options, results);
+        if (wanted("des-mt")) bench_des_parallel(options, results);
+        if (wanted("rsa")) bench_rsa_sizes(options, results);
+        if (wanted("pipeline")) bench_pipeline(options, results);
+        if (wanted("timing")) bench_timing(options, results);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 2;
+    }
+
+    if (options.format == "json") {
+        write_json(results, std::cout);
+    } else if (options.format == "csv") {
+        write_csv(results, std::cout);
+    } else {
+        std::cout << "DES / RSA benchmarks (" << std::thread::hardware_concurrency() << " hardware threads, "
+                  << "default DES engine " << des_engine_info().name << ", cycles from "
+                  << (BENCH_HAVE_RDTSC ? "rdtsc" : "n/a") << ", constant-time build "
+                  << (CRYPTOALGS_CONSTANT_TIME ? "on" : "off") << ")\n";
+        write_text(results, std::cout);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// --- Constant-Time Mode ---
+// With the CMake option CRYPTOALGS_CONSTANT_TIME, the paths that touch
+// secrets run without secret-dependent branches or memory addresses:
+//   DES   table lookups (S/P, the nibble permutations, hex key parsing) read
+//         every entry and keep the wanted one through a mask, and bulk
+//         remainders are padded into a bit-sliced pass instead of running
+//         through the scalar core.
+//   RSA   mod_exp is a Montgomery ladder over the full operand width, REDC
+//         ends in a masked subtraction, the CRT reduces and recombines in
+//         Montgomery form instead of dividing by the primes, and PKCS #1
+//         unpadding scans every byte.
+// Public-exponent operations (encryption, signature checks, the batch path)
+// keep the faster variable-time code: their inputs are public anyway. Both
+// modes compute the same results; benchmark --only=timing measures how far
+// the running time depends on the data.
+//
+// None of these paths allocate: values are fixed-width and scratch space
+// lives on the stack or in the thread arena.
+
+#ifndef CRYPTOALGS_CONSTANT_TIME
+#define CRYPTOALGS_CONSTANT_TIME 0
+#endif
+
+// Hides a value from the optimizer, so mask arithmetic is not turned back
+// into a branch on the underlying condition
+inline uint64_t ct_barrier(uint64_t value) {
+#if defined(__GNUC__)
+    __asm__("" : "+r"(value));
+#endif
+    return value;
+}
+
+// All ones if a == b, else zero
+inline uint64_t ct_eq_mask(uint64_t a, uint64_t b) {
+    uint64_t diff = ct_barrier(a ^ b);
+    return ((diff | (0 - diff)) >> 63) - 1;
+}
+
+// All ones if bit is 1, zero if it is 0
+inline uint64_t ct_bit_mask(uint64_t bit) {
+    return 0 - ct_barrier(bit & 1);
+}
+
+inline uint64_t ct_select(uint64_t mask, uint64_t if_set, uint64_t if_clear) {
+    return if_clear ^ ((if_set ^ if_clear) & mask);
+}
+
+// Function to read table[index] while touching every entry in the same
+// order. Only the index goes through the barrier, so the scan itself can
+// still vectorize; narrow tables do the mask arithmetic in 32-bit lanes.
+template <typename T, size_t N>
+inline T ct_lookup(const std::array<T, N>& table, size_t index) {
+    using Word = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+    constexpr int TOP_BIT = 8 * sizeof(Word) - 1;
+    static_assert(N <= (Word(1) << TOP_BIT), "table too large for the mask arithmetic");
+    Word target = static_cast<Word>(ct_barrier(index));
+    Word result = 0;
+    for (Word i = 0; i < N; ++i) {
+        Word diff = i ^ target;
+        result |= static_cast<Word>(table[i]) & (((diff | (0 - diff)) >> TOP_BIT) - 1);
+    }
+    return static_cast<T>(result);
+}
+
+// Table read at an index derived from key or data bits: a masked scan in
+// the constant-time build, a plain load otherwise
+template <typename T, size_t N>
+inline T secret_lookup(const std::array<T, N>& table, size_t index) {
+#if CRYPTOALGS_CONSTANT_TIME
+    return ct_lookup(table, index);
+#else
+    return table[index];
+#endif
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include "des.hpp"
+#include "feistel.hpp"
+
+// --- Davies-Meyer Hash over DES ---
+// The construction of davies_meyer.py with DES as the block cipher:
+//   H_i = E_{M_i}(H_{i-1}) XOR H_{i-1}
+// The message block is the DES key and the chaining value the plaintext.
+// DES ignores the low (parity) bit of every key byte, so a message block is
+// 56 bits (7 bytes) spread over the 7 key bits of each byte; feeding 8 raw
+// bytes would let anyone flip parity bits for free collisions. A fresh key
+// schedule per block is the cost of this construction, so compress() expands
+// straight into a stack array (no DesKeySchedule, no decrypt keys).
+// Note: a 64-bit digest is for demonstration only.
+
+class DaviesMeyerDes {
+public:
+    static constexpr size_t block_size = 7;
+    static constexpr size_t output_size = 8;
+    static constexpr uint64_t IV = 0x0123456789ABCDEFULL;
+    using Digest = std::array<uint8_t, output_size>;
+
+    DaviesMeyerDes() { reset(); }
+
+    // Function to restart from the initial value (IV)
+    void reset() {
+        state_ = IV;
+        buffered_ = 0;
+        total_length_ = 0;
+    }
+
+    // Function to absorb the next part of the message
+    void update(const uint8_t* data, size_t length) {
+        total_length_ += length;
+        absorb(data, length);
+    }
+
+    void update(const std::string& data) {
+        update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+
+    // Function to apply Merkle-Damgard strengthening (0x80, zeros, 64-bit
+    // big-endian bit length, filling a whole number of blocks) and return the
+    // digest. The hasher is reset afterwards.
+    Digest finalize() {
+        uint8_t padding[1 + block_size + 8] = {0x80};
+        size_t zeros = (block_size - (buffered_ + 1 + 8) % block_size) % block_size;
+        store_be64(padding + 1 + zeros, total_length_ * 8);
+        absorb(padding, 1 + zeros + 8);
+
+        Digest digest;
+        store_be64(digest.data(), state_);
+        reset();
+        return digest;
+    }
+
+    // Function to hash a whole message in one call
+    static Digest hash(const uint8_t* data, size_t length) {
+        DaviesMeyerDes hasher;
+        hasher.update(data, length);
+        return hasher.finalize();
+    }
+
+    static Digest hash(const std::string& message) {
+        return hash(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    }
+
+private:
+    // Function to place 56 message bits in the non-parity bits of a DES key
+    static uint64_t message_key(const uint8_t* block) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < block_size; ++i) bits = (bits << 8) | block[i];
+        uint64_t key = 0;
+        for (int i = 0; i < 8; ++i) {
+            key |= ((bits >> (49 - 7 * i)) & 0x7F) << (57 - 8 * i);
+        }
+        return key;
+    }
+
+    // Davies-Meyer compression with the message block as the key
+    void compress(const uint8_t* block) {
+        uint64_t round_keys[16];
+        generate_round_keys(message_key(block), round_keys);
+        state_ ^= des_process_block(state_, round_keys);
+    }
+
+    void absorb(const uint8_t* data, size_t length) {
+        if (buffered_ > 0) {
+            size_t take = std::min(length, block_size - buffered_);
+            std::memcpy(buffer_ + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            length -= take;
+            if (buffered_ < block_size) return;
+            compress(buffer_);
+            buffered_ = 0;
+        }
+        for (; length >= block_size; data += block_size, length -= block_size) {
+            compress(data);
+        }
+        std::memcpy(buffer_, data, length);
+        buffered_ = length;
+    }
+
+    uint64_t state_;
+    uint8_t buffer_[block_size];
+    size_t buffered_;
+    uint64_t total_length_;
+};
+
+// --- Simple Block Cipher ---
+// SimpleBlockCipher from davies_meyer.py, for 16-byte blocks and keys: 8
+// rounds, each running one byte-level Feistel round over every byte pair,
+// XORing in the key and permuting the bytes by i -> 5i mod 16.
+
+struct SimpleByteRound {
+    using Half = uint8_t;
+    using RoundKey = uint8_t;
+
+    static constexpr uint8_t apply(uint8_t right, uint8_t round_key) {
+        uint8_t temp = static_cast<uint8_t>((right ^ round_key) * 31 + 17);
+        return static_cast<uint8_t>((temp << 3) | (temp >> 5));
+    }
+};
+
+using SimpleFeistel = Feistel<SimpleByteRound, 1, uint8_t>;
+
+// Byte i of the permuted state is byte 5i mod 16 of the round input
+constexpr std::array<uint8_t, 16> build_simple_cipher_permutation() {
+    std::array<uint8_t, 16> permutation{};
+    for (size_t i = 0; i < 16; ++i) permutation[i] = static_cast<uint8_t>((i * 5) % 16);
+    return permutation;
+}
+
+inline constexpr std::array<uint8_t, 16> SIMPLE_CIPHER_PERMUTATION = build_simple_cipher_permutation();
+
+class SimpleBlockCipher {
+public:
+    static constexpr size_t block_size = 16;
+    static constexpr int rounds = 8;
+
+    // Function to encrypt one block in place
+    static void encrypt(const uint8_t key[block_size], uint8_t block[block_size]) {
+        uint8_t key_sum = 0;
+        for (size_t i = 0; i < block_size; ++i) key_sum = static_cast<uint8_t>(key_sum + key[i]);
+
+        for (int round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i + 1 < block_size; i += 2) {
+                uint8_t round_key = static_cast<uint8_t>((key_sum ^ round) + i);
+                SimpleFeistel::encrypt(block[i], block[i + 1], &round_key);
+            }
+            uint8_t mixed[block_size];
+            for (size_t i = 0; i < block_size; ++i) {
+                size_t source = SIMPLE_CIPHER_PERMUTATION[i];
+                mixed[i] = block[source] ^ key[source];
+            }
+            std::memcpy(block, mixed, block_size);
+        }
+    }
+
+    // Function to invert encrypt with the same key
+    static void decrypt(const uint8_t key[block_size], uint8_t block[block_size]) {
+        uint8_t key_sum = 0;
+        for (size_t i = 0; i < block_size; ++i) key_sum = static_cast<uint8_t>(key_sum + key[i]);
+
+        for (int round = rounds - 1; round >= 0; --round) {
+            uint8_t mixed[block_size];
+            for (size_t i = 0; i < block_size; ++i) {
+                size_t source = SIMPLE_CIPHER_PERMUTATION[i];
+                mixed[source] = block[i] ^ key[source];
+            }
+            std::memcpy(block, mixed, block_size);
+            for (size_t i = 0; i + 1 < block_size; i += 2) {
+                uint8_t round_key = static_cast<uint8_t>((key_sum ^ round) + i);
+                SimpleFeistel::decrypt(block[i], block[i + 1], &round_key);
+            }
+        }
+    }
+
+};
+
+// --- Davies-Meyer Hash over SimpleBlockCipher ---
+// DaviesMeyerHash from davies_meyer.py (16-byte blocks and digest); same
+// digests as its hash_bytes().
+
+class DaviesMeyerSimple {
+public:
+    static constexpr size_t block_size = SimpleBlockCipher::block_size;
+    static constexpr size_t output_size = block_size;
+    using Digest = std::array<uint8_t, output_size>;
+
+    // Function to hash a whole message in one call
+    static Digest hash(const uint8_t* data, size_t length) {
+        uint64_t bit_length = static_cast<uint64_t>(length) * 8;
+        Digest state;
+        for (size_t i = 0; i < output_size; ++i) state[i] = IV_BYTES[i % 8];
+
+        for (; length >= block_size; data += block_size, length -= block_size) compress(state, data);
+
+        // Merkle-Damgard strengthening: 0x80, zeros, 64-bit big-endian bit length
+        uint8_t padding[2 * block_size] = {};
+        std::memcpy(padding, data, length);
+        padding[length] = 0x80;
+        size_t padded = length + 1 + 8 <= block_size ? block_size : 2 * block_size;
+        store_be64(padding + padded - 8, bit_length);
+        for (size_t offset = 0; offset < padded; offset += block_size) compress(state, padding + offset);
+        return state;
+    }
+
+    static Digest hash(const std::string& message) {
+        return hash(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    }
+
+private:
+    // H_i = E_{M_i}(H_{i-1}) XOR H_{i-1}
+    static void compress(Digest& state, const uint8_t* block) {
+        uint8_t encrypted[block_size];
+        std::memcpy(encrypted, state.data(), block_size);
+        SimpleBlockCipher::encrypt(block, encrypted);
+        for (size_t i = 0; i < block_size; ++i) state[i] ^= encrypted[i];
+    }
+
+    static constexpr uint8_t IV_BYTES[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+};
@@ -0,0 +1,1013 @@
+#pragma once
+
+// DES and Triple DES core: tables, key schedules, the scalar block function,
+// ECB/CBC/CTR modes, the parallel drivers and PKCS#7. Part of libcryptoalgs;
+// the per-block paths stay inline here and the bit-sliced engines and their
+// run-time selection live in src/des.cpp.
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <array>
+#include <stdexcept>
+#include <cstring>
+#include <algorithm> // For std::reverse_copy in the key schedule
+#include <atomic>
+#include <thread>
+#include "mersenne_twister.hpp"
+#include "feistel.hpp"
+#include "constant_time.hpp"
+#include "metrics.hpp"
+
+// --- DES Algorithm Constants (Simplified for Illustration) ---
+
+// Initial Permutation (IP) Table (64 elements)
+// const int IP_TABLE[64] = { /* ... 64 values representing the permutation ... */ };
+inline constexpr int IP_TABLE[64] = {
+    58, 50, 42, 34, 26, 18, 10, 2,
+    60, 52, 44, 36, 28, 20, 12, 4,
+    62, 54, 46, 38, 30, 22, 14, 6,
+    64, 56, 48, 40, 32, 24, 16, 8,
+    57, 49, 41, 33, 25, 17, 9, 1,
+    59, 51, 43, 35, 27, 19, 11, 3,
+    61, 53, 45, 37, 29, 21, 13, 5,
+    63, 55, 47, 39, 31, 23, 15, 7
+};
+
+// Expansion Permutation (E) Table (32 elements expand to 48)
+// const int E_TABLE[48] = { /* ... 48 values representing the expansion ... */ };
+inline constexpr int E_TABLE[48] = {
+    32,  1,  2,  3,  4,  5,
+     4,  5,  6,  7,  8,  9,
+     8,  9, 10, 11, 12, 13,
+    12, 13, 14, 15, 16, 17,
+    16, 17, 18, 19, 20, 21,
+    20, 21, 22, 23, 24, 25,
+    24, 25, 26, 27, 28, 29,
+    28, 29, 30, 31, 32,  1
+};
+
+// P-Box Permutation (P) Table (32 elements)
+// const int P_TABLE[32] = { /* ... 32 values representing the permutation ... */ };
+inline constexpr int P_TABLE[32] = {
+    16,  7, 20, 21, 29, 12, 28, 17,
+     1, 15, 23, 26,  5, 18, 31, 10,
+     2,  8, 24, 14, 32, 27,  3,  9,
+    19, 13, 30,  6, 22, 11,  4, 25
+};
+
+// S-Box tables (8 S-boxes, each 6-bit input, 4-bit output)
+// const int S_BOXES[8][4][16] = { /* ... 8 S-box tables ... */ };
+inline constexpr int S_BOXES[8][4][16] = {
+    // S1
+    {{14, 4, 13, 1, 2, 15, 11, 8, 3, 10, 6, 12, 5, 9, 0, 7},
+     {0, 15, 7, 4, 14, 2, 13, 1, 10, 6, 12, 11, 9, 5, 3, 8},
+     {4, 1, 14, 8, 13, 6, 2, 11, 15, 12, 9, 7, 3, 10, 5, 0},
+     {15, 12, 8, 2, 4, 9, 1, 7, 5, 11, 3, 14, 10, 0, 6, 13}},
+
+    // S2
+    {{15, 1, 8, 14, 6, 11, 3, 4, 9, 7, 2, 13, 12, 0, 5, 10},
+     {3, 13, 4, 7, 15, 2, 8, 14, 12, 0, 1, 10, 6, 9, 11, 5},
+     {0, 14, 7, 11, 10, 4, 13, 1, 5, 8, 12, 6, 9, 3, 2, 15},
+     {13, 8, 10, 1, 3, 15, 4, 2, 11, 6, 7, 12, 0, 5, 14, 9}},
+
+    // S3
+    {{10, 0, 9, 14, 6, 3, 15, 5, 1, 13, 12, 7, 11, 4, 2, 8},
+     {13, 7, 0, 9, 3, 4, 6, 10, 2, 8, 5, 14, 12, 11, 15, 1},
+     {13, 6, 4, 9, 8, 15, 3, 0, 11, 1, 2, 12, 5, 10, 14, 7},
+     {1, 10, 13, 0, 6, 9, 8, 7, 4, 15, 14, 3, 11, 5, 2, 12}},
+
+    // S4
+    {{7, 13, 14, 3, 0, 6, 9, 10, 1, 2, 8, 5, 11, 12, 4, 15},
+     {13, 8, 11, 5, 6, 15, 0, 3, 4, 7, 2, 12, 1, 10, 14, 9},
+     {10, 6, 9, 0, 12, 11, 7, 13, 15, 1, 3, 14, 5, 2, 8, 4},
+     {3, 15, 0, 6, 10, 1, 13, 8, 9, 4, 5, 11, 12, 7, 2, 14}},
+
+    // S5
+    {{2, 12, 4, 1, 7, 10, 11, 6, 8, 5, 3, 15, 13, 0, 14, 9},
+     {14, 11, 2, 12, 4, 7, 13, 1, 5, 0, 15, 10, 3, 9, 8, 6},
+     {4, 2, 1, 11, 10, 13, 7, 8, 15, 9, 12, 5, 6, 3, 0, 14},
+     {11, 8, 12, 7, 1, 14, 2, 13, 6, 15, 0, 9, 10, 4, 5, 3}},
+
+    // S6
+    {{12, 1, 10, 15, 9, 2, 6, 8, 0, 13, 3, 4, 14, 7, 5, 11},
+     {10, 15, 4, 2, 7, 12, 9, 5, 6, 1, 13, 14, 0, 11, 3, 8},
+     {9, 14, 15, 5, 2, 8, 12, 3, 7, 0, 4, 10, 1, 13, 11, 6},
+     {4, 3, 2, 12, 9, 5, 15, 10, 11, 14, 1, 7, 6, 0, 8, 13}},
+
+    // S7
+    {{4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1},
+     {13, 0, 11, 7, 4, 9, 1, 10, 14, 3, 5, 12, 2, 15, 8, 6},
+     {1, 4, 11, 13, 12, 3, 7, 14, 10, 15, 6, 8, 0, 5, 9, 2},
+     {6, 11, 13, 8, 1, 4, 10, 7, 9, 5, 0, 15, 14, 2, 3, 12}},
+
+    // S8
+    {{13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7},
+     {1, 15, 13, 8, 10, 3, 7, 4, 12, 5, 6, 11, 0, 14, 9, 2},
+     {7, 11, 4, 1, 9, 12, 14, 2, 0, 6, 10, 13, 15, 3, 5, 8},
+     {2, 1, 14, 7, 4, 10, 8, 13, 15, 12, 9, 0, 3, 5, 6, 11}}
+};
+
+// Permuted Choice 1 (PC-1) Table for Key Generation (56 bits from 64-bit key)
+// const int PC1_TABLE[56] = { /* ... 56 values ... */ };
+inline constexpr int PC1_TABLE[56] = {
+    57, 49, 41, 33, 25, 17, 9, 1, 58, 50, 42, 34, 26, 18,
+    10, 2, 59, 51, 43, 35, 27, 19, 11, 3, 60, 52, 44, 36,
+    63, 55, 47, 39, 31, 23, 15, 7, 62, 54, 46, 38, 30, 22,
+    14, 6, 61, 53, 45, 37, 29, 21, 13, 5, 28, 20, 12, 4
+};
+
+// Permuted Choice 2 (PC-2) Table for Key Generation (48 bits from 56-bit shifted key)
+// const int PC2_TABLE[48] = { /* ... 48 values ... */ };
+inline constexpr int PC2_TABLE[48] = {
+    14, 17, 11, 24, 1, 5, 3, 28, 15, 6, 21, 10,
+    23, 19, 12, 4, 26, 8, 16, 7, 27, 20, 13, 2,
+    41, 52, 31, 37, 47, 55, 30, 40, 51, 45, 33, 48,
+    44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32
+};
+
+// Left Shift schedule for Key Generation (determines shifts per round)
+// const int SHIFT_SCHEDULE[16] = { /* ... 16 shift values ... */ };
+inline constexpr int SHIFT_SCHEDULE[16] = {
+    1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
+};
+
+// Inverse Initial Permutation (IP_INV) Table (64 elements)
+// const int IP_INV_TABLE[64] = { /* ... 64 values representing the inverse permutation ... */ };
+inline constexpr int IP_INV_TABLE[64] = {
+    40, 8, 48, 16, 56, 24, 64, 32, 39, 7, 47, 15, 55, 23, 63, 31,
+    38, 6, 46, 14, 54, 22, 62, 30, 37, 5, 45, 13, 53, 21, 61, 29,
+    36, 4, 44, 12, 52, 20, 60, 28, 35, 3, 43, 11, 51, 19, 59, 27,
+    34, 2, 42, 10, 50, 18, 58, 26, 33, 1, 41, 9, 49, 17, 57, 25
+};
+
+// --- Helper Functions ---
+// Blocks, halves and round keys live in plain integers with DES bit 1 in the
+// most significant position of the value, so the 1-based tables above index
+// straight into them. Nothing here touches the heap.
+
+// Function to read 8 bytes as a big-endian 64-bit block
+inline uint64_t load_be64(const uint8_t* bytes) {
+    uint64_t block = 0;
+    for (int i = 0; i < 8; ++i) {
+        block = (block << 8) | bytes[i];
+    }
+    return block;
+}
+
+// Function to write a 64-bit block as 8 big-endian bytes
+inline void store_be64(uint8_t* bytes, uint64_t block) {
+    for (int i = 7; i >= 0; --i) {
+        bytes[i] = static_cast<uint8_t>(block);
+        block >>= 8;
+    }
+}
+
+// Read-only view of a caller's bytes as a sequence of big-endian 64-bit
+// blocks. It only points at the buffer; the text must outlive the view.
+struct BitView {
+    const uint8_t* data;
+    size_t size;
+
+    size_t block_count() const { return (size + 7) / 8; }
+
+    // Block i, zero padded if the buffer ends part-way through it
+    uint64_t block(size_t i) const {
+        size_t offset = 8 * i;
+        if (offset + 8 <= size) return load_be64(data + offset);
+        uint8_t tail[8] = {};
+        for (size_t j = offset; j < size; ++j) {
+            tail[j - offset] = data[j];
+        }
+        return load_be64(tail);
+    }
+};
+
+// Function to view a string as 64-bit blocks
+// Note: Proper padding schemes (like PKCS#7) are crucial for secure implementations; see pkcs7_pad
+inline BitView string_to_bits(const std::string& text) {
+    return BitView{reinterpret_cast<const uint8_t*>(text.data()), text.size()};
+}
+
+// Function to convert a 64-bit block to an 8-character string
+inline std::string bits_to_string(uint64_t block) {
+    std::string text(8, '\0');
+    store_be64(reinterpret_cast<uint8_t*>(&text[0]), block);
+    return text;
+}
+
+// Hex digit values indexed by character, 0xFF for anything that is not a hex digit
+constexpr std::array<uint8_t, 256> build_hex_values() {
+    std::array<uint8_t, 256> values{};
+    for (int c = 0; c < 256; ++c) {
+        values[c] = 0xFF;
+    }
+    for (int d = 0; d < 10; ++d) {
+        values['0' + d] = static_cast<uint8_t>(d);
+    }
+    for (int d = 0; d < 6; ++d) {
+        values['a' + d] = values['A' + d] = static_cast<uint8_t>(10 + d);
+    }
+    return values;
+}
+
+inline constexpr std::array<uint8_t, 256> HEX_VALUES = build_hex_values();
+
+// Function to parse a 64-bit key written as 16 hex characters
+inline uint64_t parse_hex_key(const std::string& key_hex) {
+    if (key_hex.size() != 16) {
+        throw std::invalid_argument("DES key must be 16 hex characters");
+    }
+    uint64_t key = 0;
+    uint8_t invalid = 0;
+    for (char c : key_hex) {
+        uint8_t value = secret_lookup(HEX_VALUES, static_cast<uint8_t>(c));
+        invalid |= value;
+        key = (key << 4) | (value & 0xF);
+    }
+    // Only the 0xFF marker sets the high nibble
+    if (invalid & 0xF0) {
+        throw std::invalid_argument("DES key contains a non-hex character");
+    }
+    return key;
+}
+
+// Function to apply a permutation table to the low input_width bits of a word
+constexpr uint64_t apply_permutation(uint64_t input, int input_width, const int* table, int table_size) {
+    uint64_t output = 0;
+    for (int i = 0; i < table_size; ++i) {
+        output = (output << 1) | ((input >> (input_width - table[i])) & 1);
+    }
+    return output;
+}
+
+// Function to perform a circular left shift on a 28-bit key half
+inline uint32_t circular_left_shift(uint32_t half, int shift_amount) {
+    return ((half << shift_amount) | (half >> (28 - shift_amount))) & 0x0FFFFFFF;
+}
+
+// Function to rotate a 32-bit word left (amount in 0..31)
+constexpr uint32_t rotate_left32(uint32_t value, int amount) {
+    return (value << amount) | (value >> ((32 - amount) & 31));
+}
+
+// --- Nibble-Indexed Permutation Tables ---
+// A bit permutation maps each input bit on its own, so it can be applied as
+// one lookup per 4-bit nibble of the input: table[k][v] is the output for
+// nibble k (from the least significant end) holding v and every other bit
+// zero, and the lookups are ORed together. 16 lookups replace the 64
+// single-bit steps of apply_permutation, and each table is only 2 KiB.
+
+template <int InputWidth>
+using PermutationTable = std::array<std::array<uint64_t, 16>, (InputWidth + 3) / 4>;
+
+template <int InputWidth>
+constexpr PermutationTable<InputWidth> build_permutation_table(const int* table, int table_size) {
+    PermutationTable<InputWidth> result{};
+    for (int k = 0; k < (InputWidth + 3) / 4; ++k) {
+        for (int v = 0; v < 16; ++v) {
+            result[k][v] = apply_permutation(static_cast<uint64_t>(v) << (4 * k), InputWidth, table, table_size);
+        }
+    }
+    return result;
+}
+
+inline constexpr PermutationTable<64> IP_NIBBLES = build_permutation_table<64>(IP_TABLE, 64);
+inline constexpr PermutationTable<64> IP_INV_NIBBLES = build_permutation_table<64>(IP_INV_TABLE, 64);
+inline constexpr PermutationTable<64> PC1_NIBBLES = build_permutation_table<64>(PC1_TABLE, 56);
+inline constexpr PermutationTable<56> PC2_NIBBLES = build_permutation_table<56>(PC2_TABLE, 48);
+
+// Function to apply a permutation through its nibble table
+template <size_t Nibbles>
+inline uint64_t permute(uint64_t input, const std::array<std::array<uint64_t, 16>, Nibbles>& table) {
+    uint64_t output = 0;
+    for (size_t k = 0; k < Nibbles; ++k) {
+        output |= secret_lookup(table[k], (input >> (4 * k)) & 0xF);
+    }
+    return output;
+}
+
+// --- Combined S-box / P-box Tables ---
+// SP_TABLES[i][v] is the S-box i output for 6-bit input v, already moved
+// through P_TABLE into its final position in the 32-bit round output. The
+// eight S-boxes write disjoint bits, so P(S(x)) is the OR of eight lookups.
+
+using SpTables = std::array<std::array<uint32_t, 64>, 8>;
+
+constexpr SpTables build_sp_tables() {
+    SpTables sp_tables{};
+    for (int i = 0; i < 8; ++i) {
+        for (int v = 0; v < 64; ++v) {
+            // First and last bits form the row, middle four bits form the column
+            int row = ((v >> 4) & 0x2) | (v & 0x1);
+            int col = (v >> 1) & 0xF;
+
+            // Place the 4-bit output where S-box i sits in the 32-bit S output, then permute
+            uint32_t s_box_output = static_cast<uint32_t>(S_BOXES[i][row][col]) << (28 - 4 * i);
+            sp_tables[i][v] = static_cast<uint32_t>(apply_permutation(s_box_output, 32, P_TABLE, 32));
+        }
+    }
+    return sp_tables;
+}
+
+inline constexpr SpTables SP_TABLES = build_sp_tables();
+
+// The round function takes the expansion as eight overlapping 6-bit windows
+// of a rotated R instead of walking E_TABLE; make sure the table still has
+// that shape (chunk i is R bits 4i..4i+5, 1-based, wrapping 0 -> 32).
+constexpr bool e_table_is_windowed() {
+    for (int i = 0; i < 48; ++i) {
+        if (E_TABLE[i] != (4 * (i / 6) + i % 6 + 31) % 32 + 1) return false;
+    }
+    return true;
+}
+static_assert(e_table_is_windowed(), "E_TABLE no longer matches the windowed expansion in feistel()");
+
+// Function to compute the round function f(R, K) = P(S(E(R) ^ K))
+inline uint32_t feistel(uint32_t right_half, uint64_t round_key) {
+    // Rotating right by one puts R bit 32 in front of bit 1, so each window is a top-6-bit slice
+    uint32_t rotated_right = rotate_left32(right_half, 31);
+    uint32_t output = 0;
+    for (int i = 0; i < 8; ++i) {
+        uint32_t expanded_chunk = rotate_left32(rotated_right, 4 * i) >> 26;
+        uint32_t key_chunk = static_cast<uint32_t>(round_key >> (42 - 6 * i)) & 0x3F;
+        output |= secret_lookup(SP_TABLES[i], expanded_chunk ^ key_chunk);
+    }
+    return output;
+}
+
+// --- DES Key Generation ---
+
+// Returns the PC-1 output (C0 D0, 56 bits) the round keys were drawn from
+inline uint64_t generate_round_keys(uint64_t master_key, uint64_t round_keys[16]) {
+    CRYPTOALGS_COUNT(DesKeySchedules, 1);
+    CRYPTOALGS_TIME_SCOPE(KeySchedule);
+
+    // 1. Apply Permuted Choice 1 (PC-1) to get 56-bit key
+    uint64_t pc1_key = permute(master_key, PC1_NIBBLES);
+
+    // 2. Divide into two 28-bit halves (C0 and D0)
+    uint32_t c_half = static_cast<uint32_t>(pc1_key >> 28) & 0x0FFFFFFF;
+    uint32_t d_half = static_cast<uint32_t>(pc1_key) & 0x0FFFFFFF;
+
+    // 3. Perform 16 rounds of key generation
+    for (int i = 0; i < 16; ++i) {
+        // Apply circular left shifts based on SHIFT_SCHEDULE
+        c_half = circular_left_shift(c_half, SHIFT_SCHEDULE[i]);
+        d_half = circular_left_shift(d_half, SHIFT_SCHEDULE[i]);
+
+        // Concatenate C_i and D_i, then apply Permuted Choice 2 (PC-2) to get 48-bit round key
+        uint64_t combined_key = (static_cast<uint64_t>(c_half) << 28) | d_half;
+        round_keys[i] = permute(combined_key, PC2_NIBBLES);
+    }
+    return pc1_key;
+}
+
+inline void generate_round_keys(const std::string& master_key_hex, uint64_t round_keys[16]) {
+    // Convert 64-bit (16 hex characters) key to 64-bit binary
+    generate_round_keys(parse_hex_key(master_key_hex), round_keys);
+}
+
+// --- DES Key Schedule ---
+// The 16 packed 48-bit round keys for one key, in encryption order and
+// reversed for decryption. Build one per key and reuse it for every block.
+// The scalar rounds reverse the order at compile time and only read
+// encrypt_keys; decrypt_keys feeds the batch engines, which take the keys
+// in the order they are applied. key_bits feeds the keyed batch engines,
+// which slice the key itself and derive the round keys by renaming.
+
+struct DesKeySchedule {
+    uint64_t encrypt_keys[16];
+    uint64_t decrypt_keys[16];
+    uint64_t key_bits; // PC-1 output
+
+    explicit DesKeySchedule(uint64_t master_key) {
+        key_bits = generate_round_keys(master_key, encrypt_keys);
+        std::reverse_copy(encrypt_keys, encrypt_keys + 16, decrypt_keys);
+    }
+
+    explicit DesKeySchedule(const std::string& master_key_hex)
+        : DesKeySchedule(parse_hex_key(master_key_hex)) {}
+};
+
+// --- DES Block Function ---
+
+// DES as an instance of the generic network: 16 rounds of feistel() over
+// 32-bit halves, unrolled
+struct DesRound {
+    using Half = uint32_t;
+    using RoundKey = uint64_t;
+
+    static uint32_t apply(uint32_t right_half, uint64_t round_key) {
+        return feistel(right_half, round_key);
+    }
+};
+
+using DesFeistel = Feistel<DesRound, 16, uint32_t>;
+
+// Performs the 16 Feistel rounds on an IP-permuted block (L0 || R0) and
+// returns the pre-output R16 || L16, i.e. with the halves swapped back.
+// Reverse takes the round keys last to first, which makes the pass a
+// decryption under the same (encryption order) keys.
+template <bool Reverse = false>
+inline uint64_t des_rounds(uint64_t block, const uint64_t round_keys[16]) {
+    // Divide into Left and Right 32-bit halves
+    uint32_t left_half = static_cast<uint32_t>(block >> 32);
+    uint32_t right_half = static_cast<uint32_t>(block);
+
+    DesFeistel::run<Reverse>(left_half, right_half, round_keys);
+
+    return (static_cast<uint64_t>(right_half) << 32) | left_half;
+}
+
+// Runs IP, the 16 Feistel rounds and IP_INV over one block
+template <bool Reverse = false>
+inline uint64_t des_process_block(uint64_t block, const uint64_t round_keys[16]) {
+    // Apply Initial Permutation (IP), the rounds, then Inverse Initial Permutation (IP_INV)
+    block = permute(block, IP_NIBBLES);
+    block = des_rounds<Reverse>(block, round_keys);
+    return permute(block, IP_INV_NIBBLES);
+}
+
+// --- DES Encryption Function ---
+
+inline uint64_t des_encrypt(uint64_t block, const DesKeySchedule& schedule) {
+    CRYPTOALGS_COUNT(DesBlocks, 1);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    return des_process_block(block, schedule.encrypt_keys);
+}
+
+inline std::string des_encrypt(const std::string& plaintext, const DesKeySchedule& schedule) {
+    // Convert plaintext to a 64-bit block, run the network, convert back to string (ciphertext)
+    return bits_to_string(des_encrypt(string_to_bits(plaintext).block(0), schedule));
+}
+
+inline std::string des_encrypt(const std::string& plaintext, const std::string& key_hex) {
+    // One-off call: expand the key just for this block
+    return des_encrypt(plaintext, DesKeySchedule(key_hex));
+}
+
+// --- DES Decryption Function ---
+
+// Decryption is the same network with the round keys applied in reverse order
+inline uint64_t des_decrypt(uint64_t block, const DesKeySchedule& schedule) {
+    CRYPTOALGS_COUNT(DesBlocks, 1);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    return des_process_block<true>(block, schedule.encrypt_keys);
+}
+
+inline std::string des_decrypt(const std::string& ciphertext, const DesKeySchedule& schedule) {
+    return bits_to_string(des_decrypt(string_to_bits(ciphertext).block(0), schedule));
+}
+
+inline std::string des_decrypt(const std::string& ciphertext, const std::string& key_hex) {
+    return des_decrypt(ciphertext, DesKeySchedule(key_hex));
+}
+
+// --- Block Engines ---
+// Bulk work runs on the scalar core above or on a bit-sliced engine that
+// takes 64 to 512 independent blocks per pass (src/des.cpp). The widest
+// engine the CPU supports is picked on first use.
+
+enum class DesEngine { Scalar, Bitslice64, Bitslice128, Bitslice256, Bitslice512 };
+
+// Key and direction of one block in a keyed batch
+struct DesLaneKey {
+    const DesKeySchedule* schedule;
+    bool decrypt;
+
+    const uint64_t* round_keys() const { return decrypt ? schedule->decrypt_keys : schedule->encrypt_keys; }
+};
+
+using BitslicePassFn = void (*)(const uint64_t*, uint64_t*, const uint64_t[16]);
+// Block i under keys[i]
+using BitsliceKeyedPassFn = void (*)(const uint64_t*, uint64_t*, const DesLaneKey*);
+
+struct DesEngineInfo {
+    DesEngine engine;
+    const char* name;
+    size_t blocks_per_pass; // 0 for the scalar engine
+    BitslicePassFn pass;
+    BitsliceKeyedPassFn keyed_pass;
+};
+
+// Active engine, detected on first use
+const DesEngineInfo& des_engine_info();
+
+// Overrides the automatic choice (e.g. for benchmarks). Returns false if the
+// engine is not available on this CPU or build.
+bool des_set_engine(DesEngine engine);
+
+// Widest bit-sliced pass (the AVX-512 engine)
+inline constexpr size_t DES_MAX_PASS_BLOCKS = 512;
+
+// Runs fewer than a pass worth of blocks through stages bit-sliced passes,
+// padded out with zero blocks whose output is dropped. The constant-time
+// build sends remainders here instead of through the table-driven core.
+inline void des_padded_pass(const DesEngineInfo& info, const uint64_t* in, uint64_t* out, size_t count,
+                            const uint64_t* const* stages, size_t stage_count) {
+    uint64_t padded[DES_MAX_PASS_BLOCKS] = {};
+    std::copy(in, in + count, padded);
+    for (size_t stage = 0; stage < stage_count; ++stage) info.pass(padded, padded, stages[stage]);
+    std::copy(padded, padded + count, out);
+}
+
+// Runs count independent blocks through DES with the given round key order,
+// full passes on the active bit-sliced engine and the remainder on the scalar core
+inline void des_process_blocks(const uint64_t* in, uint64_t* out, size_t count, const uint64_t round_keys[16]) {
+    CRYPTOALGS_COUNT(DesBlocks, count);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    const DesEngineInfo& info = des_engine_info();
+    size_t i = 0;
+    if (info.pass != nullptr) {
+        for (; i + info.blocks_per_pass <= count; i += info.blocks_per_pass) {
+            info.pass(in + i, out + i, round_keys);
+        }
+#if CRYPTOALGS_CONSTANT_TIME
+        if (i < count) {
+            des_padded_pass(info, in + i, out + i, count - i, &round_keys, 1);
+            i = count;
+        }
+#endif
+    }
+    for (; i < count; ++i) {
+        out[i] = des_process_block(in[i], round_keys);
+    }
+}
+
+// Runs count independent blocks through DES, block i under keys[i] (any mix
+// of schedules and directions), so short messages under different keys can
+// still fill bit-sliced passes
+inline void des_process_blocks_keyed(const uint64_t* in, uint64_t* out, size_t count, const DesLaneKey* keys) {
+    CRYPTOALGS_COUNT(DesBlocks, count);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    const DesEngineInfo& info = des_engine_info();
+    size_t i = 0;
+    if (info.keyed_pass != nullptr) {
+        for (; i + info.blocks_per_pass <= count; i += info.blocks_per_pass) {
+            info.keyed_pass(in + i, out + i, keys + i);
+        }
+#if CRYPTOALGS_CONSTANT_TIME
+        if (i < count) {
+            uint64_t padded[DES_MAX_PASS_BLOCKS] = {};
+            DesLaneKey padded_keys[DES_MAX_PASS_BLOCKS];
+            std::copy(in + i, in + count, padded);
+            std::copy(keys + i, keys + count, padded_keys);
+            std::fill(padded_keys + (count - i), padded_keys + DES_MAX_PASS_BLOCKS, keys[i]);
+            info.keyed_pass(padded, padded, padded_keys);
+            std::copy(padded, padded + (count - i), out + i);
+            i = count;
+        }
+#endif
+    }
+    for (; i < count; ++i) {
+        out[i] = des_process_block(in[i], keys[i].round_keys());
+    }
+}
+
+// --- Multi-Block Modes (ECB / CBC / CTR) ---
+// Bulk entry points work on contiguous buffers of 8-byte blocks and read each
+// block straight into a word, so there are no per-block strings or vectors.
+// in and out may be the same buffer. For CBC and CTR, iv holds the 8-byte
+// chaining value / counter block and is advanced on return, so a long stream
+// can be fed through in several calls. ECB ignores iv.
+
+enum class Mode { ECB, CBC, CTR };
+
+// Modes without a chain between block encryptions (ECB, CTR, CBC decryption)
+// gather a tile of blocks into words and hand the whole tile to a batch
+// function, so a bit-sliced engine can take full passes. The tile is the
+// widest engine pass. CBC encryption is inherently one block at a time.
+inline constexpr size_t MODE_TILE_BLOCKS = 512;
+
+// Function to draw count fresh 8-byte IVs / initial counter blocks in one
+// bulk request. MT19937 gives unique-looking values but is predictable, so it
+// should not be relied on where CBC needs an unpredictable IV; draw those
+// from secure_random_fill (rsa.hpp) instead.
+inline void des_generate_iv(uint8_t* iv, size_t count = 1) {
+    thread_mersenne_twister().fill(iv, 8 * count);
+}
+
+template <typename BatchFn>
+inline void ecb_blocks(const uint8_t* in, uint8_t* out, size_t nblocks, BatchFn batch_fn) {
+    CRYPTOALGS_COUNT(EcbBlocks, nblocks);
+    CRYPTOALGS_COUNT(ModeBytes, 8 * nblocks);
+    uint64_t tile[MODE_TILE_BLOCKS];
+    for (size_t i = 0; i < nblocks; i += MODE_TILE_BLOCKS) {
+        size_t count = std::min(MODE_TILE_BLOCKS, nblocks - i);
+        for (size_t k = 0; k < count; ++k) {
+            tile[k] = load_be64(in + 8 * (i + k));
+        }
+        batch_fn(tile, tile, count);
+        for (size_t k = 0; k < count; ++k) {
+            store_be64(out + 8 * (i + k), tile[k]);
+        }
+    }
+}
+
+template <typename BlockFn>
+inline uint64_t cbc_encrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks, uint64_t chain, BlockFn encrypt_fn) {
+    CRYPTOALGS_COUNT(CbcBlocks, nblocks);
+    CRYPTOALGS_COUNT(ModeBytes, 8 * nblocks);
+    for (size_t i = 0; i < nblocks; ++i) {
+        chain = encrypt_fn(load_be64(in + 8 * i) ^ chain);
+        store_be64(out + 8 * i, chain);
+    }
+    return chain;
+}
+
+// CBC decryption has no dependency between the block decryptions, only in
+// the XOR that follows: a tile is decrypted as one batch, then the chaining
+// XOR runs as a separate pass over the tile.
+template <typename BatchFn>
+inline uint64_t cbc_decrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks, uint64_t chain, BatchFn decrypt_fn) {
+    CRYPTOALGS_COUNT(CbcBlocks, nblocks);
+    CRYPTOALGS_COUNT(ModeBytes, 8 * nblocks);
+    uint64_t ciphertext_blocks[MODE_TILE_BLOCKS];
+    uint64_t plaintext_blocks[MODE_TILE_BLOCKS];
+    for (size_t i = 0; i < nblocks; i += MODE_TILE_BLOCKS) {
+        size_t count = std::min(MODE_TILE_BLOCKS, nblocks - i);
+        // Read the whole tile first so in == out is safe
+        for (size_t k = 0; k < count; ++k) {
+            ciphertext_blocks[k] = load_be64(in + 8 * (i + k));
+        }
+        decrypt_fn(ciphertext_blocks, plaintext_blocks, count);
+        plaintext_blocks[0] ^= chain;
+        for (size_t k = 1; k < count; ++k) {
+            plaintext_blocks[k] ^= ciphertext_blocks[k - 1];
+        }
+        for (size_t k = 0; k < count; ++k) {
+            store_be64(out + 8 * (i + k), plaintext_blocks[k]);
+        }
+        chain = ciphertext_blocks[count - 1];
+    }
+    return chain;
+}
+
+// CTR treats the whole 8-byte counter block as one big-endian integer
+template <typename BatchFn>
+inline uint64_t ctr_blocks(const uint8_t* in, uint8_t* out, size_t nblocks, uint64_t counter, BatchFn encrypt_fn) {
+    CRYPTOALGS_COUNT(CtrBlocks, nblocks);
+    CRYPTOALGS_COUNT(ModeBytes, 8 * nblocks);
+    uint64_t keystream[MODE_TILE_BLOCKS];
+    for (size_t i = 0; i < nblocks; i += MODE_TILE_BLOCKS) {
+        size_t count = std::min(MODE_TILE_BLOCKS, nblocks - i);
+        for (size_t k = 0; k < count; ++k) {
+            keystream[k] = counter++;
+        }
+        encrypt_fn(keystream, keystream, count);
+        for (size_t k = 0; k < count; ++k) {
+            store_be64(out + 8 * (i + k), load_be64(in + 8 * (i + k)) ^ keystream[k]);
+        }
+    }
+    return counter;
+}
+
+// The *_blocks entry points take the IV (CBC) or counter block (CTR) in iv
+// and leave the next one there; ECB ignores it
+inline void require_iv(Mode mode, const uint8_t* iv) {
+    if (mode != Mode::ECB && iv == nullptr) throw std::invalid_argument("CBC/CTR need an IV");
+}
+
+inline void des_encrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks,
+                               const DesKeySchedule& schedule, Mode mode, uint8_t* iv = nullptr) {
+    require_iv(mode, iv);
+    auto batch_fn = [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+        des_process_blocks(blocks_in, blocks_out, count, schedule.encrypt_keys);
+    };
+    switch (mode) {
+        case Mode::ECB:
+            ecb_blocks(in, out, nblocks, batch_fn);
+            break;
+        case Mode::CBC: {
+            auto encrypt_fn = [&schedule](uint64_t block) { return des_encrypt(block, schedule); };
+            store_be64(iv, cbc_encrypt_blocks(in, out, nblocks, load_be64(iv), encrypt_fn));
+            break;
+        }
+        case Mode::CTR:
+            store_be64(iv, ctr_blocks(in, out, nblocks, load_be64(iv), batch_fn));
+            break;
+    }
+}
+
+inline void des_decrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks,
+                               const DesKeySchedule& schedule, Mode mode, uint8_t* iv = nullptr) {
+    require_iv(mode, iv);
+    auto batch_fn = [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+        des_process_blocks(blocks_in, blocks_out, count, schedule.decrypt_keys);
+    };
+    switch (mode) {
+        case Mode::ECB:
+            ecb_blocks(in, out, nblocks, batch_fn);
+            break;
+        case Mode::CBC:
+            store_be64(iv, cbc_decrypt_blocks(in, out, nblocks, load_be64(iv), batch_fn));
+            break;
+        case Mode::CTR:
+            // CTR is its own inverse: the keystream always comes from encryption
+            des_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+            break;
+    }
+}
+
+// --- Triple DES (EDE) ---
+// C = E_K3(D_K2(E_K1(P))). The three key schedules are expanded once, and
+// since IP_INV at the end of one stage is undone by IP at the start of the
+// next, a block only pays for IP once, 48 rounds, and IP_INV once.
+
+struct TripleDesKeySchedule {
+    DesKeySchedule k1;
+    DesKeySchedule k2;
+    DesKeySchedule k3;
+
+    TripleDesKeySchedule(uint64_t key1, uint64_t key2, uint64_t key3)
+        : k1(key1), k2(key2), k3(key3) {}
+
+    // 32 hex characters for two-key 3DES (K3 = K1) or 48 for three keys
+    explicit TripleDesKeySchedule(const std::string& key_hex)
+        : TripleDesKeySchedule(split_key(key_hex, 0), split_key(key_hex, 1),
+                               split_key(key_hex, key_hex.size() == 32 ? 0 : 2)) {}
+
+private:
+    static uint64_t split_key(const std::string& key_hex, size_t index) {
+        if (key_hex.size() != 32 && key_hex.size() != 48) {
+            throw std::invalid_argument("3DES key must be 32 or 48 hex characters");
+        }
+        return parse_hex_key(key_hex.substr(16 * index, 16));
+    }
+};
+
+inline uint64_t tdes_encrypt(uint64_t block, const TripleDesKeySchedule& schedule) {
+    CRYPTOALGS_COUNT(DesBlocks, 3);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    block = permute(block, IP_NIBBLES);
+    block = des_rounds(block, schedule.k1.encrypt_keys);
+    block = des_rounds<true>(block, schedule.k2.encrypt_keys);
+    block = des_rounds(block, schedule.k3.encrypt_keys);
+    return permute(block, IP_INV_NIBBLES);
+}
+
+inline uint64_t tdes_decrypt(uint64_t block, const TripleDesKeySchedule& schedule) {
+    CRYPTOALGS_COUNT(DesBlocks, 3);
+    CRYPTOALGS_TIME_SCOPE(DesBlocks);
+    block = permute(block, IP_NIBBLES);
+    block = des_rounds<true>(block, schedule.k3.encrypt_keys);
+    block = des_rounds(block, schedule.k2.encrypt_keys);
+    block = des_rounds<true>(block, schedule.k1.encrypt_keys);
+    return permute(block, IP_INV_NIBBLES);
+}
+
+// Batch form for the mode loops: full bit-sliced passes run stage by stage
+// (IP/IP_INV are free renames there), the remainder uses the fused scalar
+// path, which counts itself
+inline void tdes_process_blocks(const uint64_t* in, uint64_t* out, size_t count,
+                                const TripleDesKeySchedule& schedule, bool decrypt) {
+    const DesEngineInfo& info = des_engine_info();
+    size_t i = 0;
+    if (info.pass != nullptr && (CRYPTOALGS_CONSTANT_TIME || count >= info.blocks_per_pass)) {
+        CRYPTOALGS_TIME_SCOPE(DesBlocks);
+        const uint64_t* stages[3] = {schedule.k1.encrypt_keys, schedule.k2.decrypt_keys, schedule.k3.encrypt_keys};
+        if (decrypt) {
+            stages[0] = schedule.k3.decrypt_keys;
+            stages[1] = schedule.k2.encrypt_keys;
+            stages[2] = schedule.k1.decrypt_keys;
+        }
+        for (; i + info.blocks_per_pass <= count; i += info.blocks_per_pass) {
+            info.pass(in + i, out + i, stages[0]);
+            info.pass(out + i, out + i, stages[1]);
+            info.pass(out + i, out + i, stages[2]);
+        }
+#if CRYPTOALGS_CONSTANT_TIME
+        if (i < count) {
+            des_padded_pass(info, in + i, out + i, count - i, stages, 3);
+            i = count;
+        }
+#endif
+        CRYPTOALGS_COUNT(DesBlocks, 3 * i);
+    }
+    for (; i < count; ++i) {
+        out[i] = decrypt ? tdes_decrypt(in[i], schedule) : tdes_encrypt(in[i], schedule);
+    }
+}
+
+inline void tdes_encrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks,
+                                const TripleDesKeySchedule& schedule, Mode mode, uint8_t* iv = nullptr) {
+    require_iv(mode, iv);
+    auto batch_fn = [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+        tdes_process_blocks(blocks_in, blocks_out, count, schedule, false);
+    };
+    switch (mode) {
+        case Mode::ECB:
+            ecb_blocks(in, out, nblocks, batch_fn);
+            break;
+        case Mode::CBC: {
+            auto encrypt_fn = [&schedule](uint64_t block) { return tdes_encrypt(block, schedule); };
+            store_be64(iv, cbc_encrypt_blocks(in, out, nblocks, load_be64(iv), encrypt_fn));
+            break;
+        }
+        case Mode::CTR:
+            store_be64(iv, ctr_blocks(in, out, nblocks, load_be64(iv), batch_fn));
+            break;
+    }
+}
+
+inline void tdes_decrypt_blocks(const uint8_t* in, uint8_t* out, size_t nblocks,
+                                const TripleDesKeySchedule& schedule, Mode mode, uint8_t* iv = nullptr) {
+    require_iv(mode, iv);
+    auto batch_fn = [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+        tdes_process_blocks(blocks_in, blocks_out, count, schedule, true);
+    };
+    switch (mode) {
+        case Mode::ECB:
+            ecb_blocks(in, out, nblocks, batch_fn);
+            break;
+        case Mode::CBC:
+            store_be64(iv, cbc_decrypt_blocks(in, out, nblocks, load_be64(iv), batch_fn));
+            break;
+        case Mode::CTR:
+            tdes_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+            break;
+    }
+}
+
+// --- crypto_manager.py CTR Layout ---
+// The CTR fallback crypto_manager.py runs for TripleDES: the block at byte
+// offset i of the stream uses the nonce with its last two bytes replaced by
+// (those bytes + i), with no carry. Python cannot encode a sum past 16 bits,
+// so such streams end below 64 KiB and a longer one throws. offset is the
+// stream position of in[0] (a multiple of 8), and length need not be a whole
+// number of blocks.
+
+template <typename BatchFn>
+inline void ctr_offset_bytes(const uint8_t* in, uint8_t* out, size_t length, const uint8_t* nonce,
+                             uint64_t offset, BatchFn encrypt_fn) {
+    uint64_t base = load_be64(nonce);
+    uint64_t low = base & 0xFFFF;
+    if (length > 0 && low + offset + 8 * ((length - 1) / 8) > 0xFFFF) {
+        throw std::overflow_error("stream too long for the 16-bit crypto_manager CTR counter");
+    }
+    CRYPTOALGS_COUNT(CtrBlocks, (length + 7) / 8);
+    CRYPTOALGS_COUNT(ModeBytes, length);
+    uint64_t keystream[MODE_TILE_BLOCKS];
+    for (size_t done = 0; done < length;) {
+        size_t count = std::min(MODE_TILE_BLOCKS, (length - done + 7) / 8);
+        for (size_t k = 0; k < count; ++k) {
+            keystream[k] = (base & ~uint64_t(0xFFFF)) | (low + offset + done + 8 * k);
+        }
+        encrypt_fn(keystream, keystream, count);
+        for (size_t k = 0; k < count; ++k, done += 8) {
+            uint8_t block[8];
+            store_be64(block, keystream[k]);
+            size_t take = std::min<size_t>(8, length - done);
+            for (size_t b = 0; b < take; ++b) out[done + b] = in[done + b] ^ block[b];
+        }
+    }
+}
+
+inline void des_ctr_offset(const uint8_t* in, uint8_t* out, size_t length, const DesKeySchedule& schedule,
+                           const uint8_t* nonce, uint64_t offset = 0) {
+    ctr_offset_bytes(in, out, length, nonce, offset,
+                     [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                         des_process_blocks(blocks_in, blocks_out, count, schedule.encrypt_keys);
+                     });
+}
+
+inline void tdes_ctr_offset(const uint8_t* in, uint8_t* out, size_t length, const TripleDesKeySchedule& schedule,
+                            const uint8_t* nonce, uint64_t offset = 0) {
+    ctr_offset_bytes(in, out, length, nonce, offset,
+                     [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                         tdes_process_blocks(blocks_in, blocks_out, count, schedule, false);
+                     });
+}
+
+// --- Parallel Chunk Scheduler ---
+// Splits work into fixed-size chunks that workers claim from a shared atomic
+// index, so a thread that finishes early simply takes the next chunk. The
+// calling thread works too; thread_count == 0 means one per hardware thread.
+
+inline constexpr size_t PARALLEL_CHUNK_BLOCKS = 4096; // 32 KiB of data per chunk, sized to stay in L2
+
+template <typename ChunkFn>
+inline void run_parallel_chunks(size_t nblocks, unsigned thread_count, ChunkFn chunk_fn) {
+    size_t chunk_count = (nblocks + PARALLEL_CHUNK_BLOCKS - 1) / PARALLEL_CHUNK_BLOCKS;
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t worker_count = std::min<size_t>(thread_count, chunk_count);
+
+    std::atomic<size_t> next_chunk{0};
+    auto worker = [&]() {
+        for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+            size_t first = chunk * PARALLEL_CHUNK_BLOCKS;
+            chunk_fn(first, std::min(PARALLEL_CHUNK_BLOCKS, nblocks - first));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+// Multi-threaded CTR. Block i always uses counter + i, so the output is
+// byte-identical to des_encrypt_blocks(..., Mode::CTR, counter), and the
+// counter is advanced the same way.
+template <typename BatchFn>
+inline void ctr_parallel(const uint8_t* in, uint8_t* out, size_t nblocks, uint8_t* counter,
+                         unsigned thread_count, BatchFn encrypt_fn) {
+    uint64_t base_counter = load_be64(counter);
+    run_parallel_chunks(nblocks, thread_count, [&](size_t first, size_t count) {
+        ctr_blocks(in + 8 * first, out + 8 * first, count, base_counter + first, encrypt_fn);
+    });
+    store_be64(counter, base_counter + nblocks);
+}
+
+// Multi-threaded CBC decryption. Each chunk only needs the ciphertext block
+// just before it, so those are captured up front (keeping in == out safe) and
+// the chunks are then decrypted on the scheduler like CTR. iv is advanced to
+// the last ciphertext block, as with des_decrypt_blocks.
+template <typename BatchFn>
+inline void cbc_decrypt_parallel(const uint8_t* in, uint8_t* out, size_t nblocks, uint8_t* iv,
+                                 unsigned thread_count, BatchFn decrypt_fn) {
+    if (nblocks == 0) return;
+    size_t chunk_count = (nblocks + PARALLEL_CHUNK_BLOCKS - 1) / PARALLEL_CHUNK_BLOCKS;
+    std::vector<uint64_t> chunk_chains(chunk_count);
+    chunk_chains[0] = load_be64(iv);
+    for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+        chunk_chains[chunk] = load_be64(in + 8 * (chunk * PARALLEL_CHUNK_BLOCKS - 1));
+    }
+    uint64_t last_ciphertext = load_be64(in + 8 * (nblocks - 1));
+
+    run_parallel_chunks(nblocks, thread_count, [&](size_t first, size_t count) {
+        cbc_decrypt_blocks(in + 8 * first, out + 8 * first, count,
+                           chunk_chains[first / PARALLEL_CHUNK_BLOCKS], decrypt_fn);
+    });
+    store_be64(iv, last_ciphertext);
+}
+
+inline void des_ctr_parallel(const uint8_t* in, uint8_t* out, size_t nblocks,
+                             const DesKeySchedule& schedule, uint8_t* counter, unsigned thread_count = 0) {
+    ctr_parallel(in, out, nblocks, counter, thread_count,
+                 [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                     des_process_blocks(blocks_in, blocks_out, count, schedule.encrypt_keys);
+                 });
+}
+
+inline void des_cbc_decrypt_parallel(const uint8_t* in, uint8_t* out, size_t nblocks,
+                                     const DesKeySchedule& schedule, uint8_t* iv, unsigned thread_count = 0) {
+    cbc_decrypt_parallel(in, out, nblocks, iv, thread_count,
+                         [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                             des_process_blocks(blocks_in, blocks_out, count, schedule.decrypt_keys);
+                         });
+}
+
+inline void tdes_ctr_parallel(const uint8_t* in, uint8_t* out, size_t nblocks,
+                              const TripleDesKeySchedule& schedule, uint8_t* counter, unsigned thread_count = 0) {
+    ctr_parallel(in, out, nblocks, counter, thread_count,
+                 [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                     tdes_process_blocks(blocks_in, blocks_out, count, schedule, false);
+                 });
+}
+
+inline void tdes_cbc_decrypt_parallel(const uint8_t* in, uint8_t* out, size_t nblocks,
+                                      const TripleDesKeySchedule& schedule, uint8_t* iv, unsigned thread_count = 0) {
+    cbc_decrypt_parallel(in, out, nblocks, iv, thread_count,
+                         [&schedule](const uint64_t* blocks_in, uint64_t* blocks_out, size_t count) {
+                             tdes_process_blocks(blocks_in, blocks_out, count, schedule, true);
+                         });
+}
+
+// --- PKCS#7 Padding ---
+
+// Size of a message once padded: always at least one byte of padding
+inline size_t pkcs7_padded_size(size_t length) {
+    return (length / 8 + 1) * 8;
+}
+
+// Writes the padding bytes after the first length bytes of buffer, which
+// must hold pkcs7_padded_size(length) bytes. Returns the padded size.
+inline size_t pkcs7_pad(uint8_t* buffer, size_t length) {
+    size_t padded_size = pkcs7_padded_size(length);
+    uint8_t pad_value = static_cast<uint8_t>(padded_size - length);
+    for (size_t i = length; i < padded_size; ++i) {
+        buffer[i] = pad_value;
+    }
+    return padded_size;
+}
+
+// Validates the padding at the end of a decrypted buffer and stores the
+// message length in length. Returns false if the padding is malformed.
+inline bool pkcs7_unpad(const uint8_t* buffer, size_t padded_size, size_t& length) {
+    if (padded_size == 0 || padded_size % 8 != 0) return false;
+    uint8_t pad_value = buffer[padded_size - 1];
+    if (pad_value == 0 || pad_value > 8) return false;
+    for (size_t i = padded_size - pad_value; i < padded_size; ++i) {
+        if (buffer[i] != pad_value) return false;
+    }
+    length = padded_size - pad_value;
+    return true;
+}
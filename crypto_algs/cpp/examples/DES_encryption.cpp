@@ -0,0 +1,86 @@
+#include <iostream>
+#include "des.hpp"
+
+// Function to format bytes as hex for display
+std::string to_hex(const uint8_t* bytes, size_t length) {
+    static const char digits[] = "0123456789ABCDEF";
+    std::string hex(2 * length, '0');
+    for (size_t i = 0; i < length; ++i) {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0xF];
+    }
+    return hex;
+}
+
+int main() {
+    std::string plaintext = "HelloDES"; // One 8-character (64-bit) block
+    std::string key = "133457799BBCDFF1"; // 16 hex characters (64 bits), effective 56-bit key used
+
+    // Expand the key once and reuse it for both directions
+    DesKeySchedule schedule(key);
+
+    // Encrypt the plaintext
+    std::string ciphertext = des_encrypt(plaintext, schedule);
+
+    // Decrypt the ciphertext
+    std::string decrypted_text = des_decrypt(ciphertext, schedule);
+
+    std::cout << "Original Text: " << plaintext << std::endl;
+    std::cout << "Encrypted Text (Hex): "
+              << to_hex(reinterpret_cast<const uint8_t*>(ciphertext.data()), ciphertext.size()) << std::endl;
+    std::cout << "Decrypted Text: " << decrypted_text << std::endl;
+
+    // Longer messages go through the bulk API: PKCS#7 pad, then CBC in place
+    std::string message = "Messages longer than one block are padded and chained.";
+    std::vector<uint8_t> buffer(pkcs7_padded_size(message.size()));
+    std::copy(message.begin(), message.end(), buffer.begin());
+    size_t padded_size = pkcs7_pad(buffer.data(), message.size());
+
+    const uint8_t initial_iv[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    uint8_t iv[8];
+    std::copy(initial_iv, initial_iv + 8, iv);
+    des_encrypt_blocks(buffer.data(), buffer.data(), padded_size / 8, schedule, Mode::CBC, iv);
+    std::cout << "CBC Encrypted (Hex): " << to_hex(buffer.data(), padded_size) << std::endl;
+
+    std::copy(initial_iv, initial_iv + 8, iv);
+    des_decrypt_blocks(buffer.data(), buffer.data(), padded_size / 8, schedule, Mode::CBC, iv);
+    size_t message_size = 0;
+    if (!pkcs7_unpad(buffer.data(), padded_size, message_size)) {
+        std::cerr << "Invalid padding after CBC decryption.\n";
+        return 1;
+    }
+    std::cout << "CBC Decrypted: " << std::string(buffer.begin(), buffer.begin() + message_size) << std::endl;
+
+    // CTR from a freshly generated initial counter block; decryption is the same keystream XOR
+    uint8_t initial_counter[8], counter[8];
+    des_generate_iv(initial_counter);
+    std::vector<uint8_t> stream(message.begin(), message.end());
+    size_t stream_blocks = (stream.size() + 7) / 8;
+    stream.resize(8 * stream_blocks);
+    std::copy(initial_counter, initial_counter + 8, counter);
+    des_encrypt_blocks(stream.data(), stream.data(), stream_blocks, schedule, Mode::CTR, counter);
+    std::cout << "CTR Counter: " << to_hex(initial_counter, 8)
+              << ", Encrypted (Hex): " << to_hex(stream.data(), message.size()) << std::endl;
+    std::copy(initial_counter, initial_counter + 8, counter);
+    des_decrypt_blocks(stream.data(), stream.data(), stream_blocks, schedule, Mode::CTR, counter);
+    std::cout << "CTR Decrypted: " << std::string(stream.begin(), stream.begin() + message.size()) << std::endl;
+
+    // Triple DES (EDE) with three independent keys on the same buffer API
+    TripleDesKeySchedule tdes_schedule("0123456789ABCDEF23456789ABCDEF01456789ABCDEF0123");
+    std::copy(message.begin(), message.end(), buffer.begin());
+    pkcs7_pad(buffer.data(), message.size());
+
+    std::copy(initial_iv, initial_iv + 8, iv);
+    tdes_encrypt_blocks(buffer.data(), buffer.data(), padded_size / 8, tdes_schedule, Mode::CBC, iv);
+    std::cout << "3DES CBC Encrypted (Hex): " << to_hex(buffer.data(), padded_size) << std::endl;
+
+    std::copy(initial_iv, initial_iv + 8, iv);
+    tdes_decrypt_blocks(buffer.data(), buffer.data(), padded_size / 8, tdes_schedule, Mode::CBC, iv);
+    if (!pkcs7_unpad(buffer.data(), padded_size, message_size)) {
+        std::cerr << "Invalid padding after 3DES CBC decryption.\n";
+        return 1;
+    }
+    std::cout << "3DES CBC Decrypted: " << std::string(buffer.begin(), buffer.begin() + message_size) << std::endl;
+
+    return 0;
+}
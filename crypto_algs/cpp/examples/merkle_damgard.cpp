@@ -0,0 +1,56 @@
+#include <iostream>
+#include <string>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "merkle_damgard.hpp"
+
+// Function to format a digest as hex
+template <size_t N>
+std::string to_hex(const std::array<uint8_t, N>& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(2 * N, '0');
+    for (size_t i = 0; i < N; ++i) {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0xF];
+    }
+    return hex;
+}
+
+int main() {
+    using Hasher = MerkleDamgardHash<64, 32>;
+
+    const std::string test_messages[] = {
+        "Hello, World!",
+        "The quick brown fox jumps over the lazy dog",
+        "",
+        "a",
+        "abc",
+        "message digest",
+        "abcdefghijklmnopqrstuvwxyz",
+        std::string(1000, 'A'),
+    };
+
+    std::cout << "Merkle-Damgard Hash Function Demonstration\n";
+    std::cout << "Block size: " << Hasher::block_size << " bytes\n";
+    std::cout << "Output size: " << Hasher::output_size << " bytes\n\n";
+
+    for (const std::string& msg : test_messages) {
+        std::string display_msg = msg.size() <= 50 ? msg : msg.substr(0, 47) + "...";
+        std::cout << "Message: '" << display_msg << "'\n";
+        std::cout << "Hash:    " << to_hex(Hasher::hash(msg)) << "\n\n";
+    }
+
+    // Streaming: the same digest when the input arrives in uneven pieces
+    const std::string& long_msg = test_messages[7];
+    Hasher hasher;
+    for (size_t offset = 0, piece = 1; offset < long_msg.size(); offset += piece, piece = piece * 2 + 1) {
+        size_t take = std::min(piece, long_msg.size() - offset);
+        hasher.update(reinterpret_cast<const uint8_t*>(long_msg.data()) + offset, take);
+    }
+    bool streaming_matches = hasher.finalize() == Hasher::hash(long_msg);
+    std::cout << "Streaming update matches one-shot hash: " << (streaming_matches ? "yes" : "no") << "\n";
+
+    return streaming_matches ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include "merkle_tree.hpp"
+
+using Tree = MerkleTreeHash<MerkleDamgardHash<64, 32>, 64 * 1024>;
+
+// Function to format a digest as hex
+std::string to_hex(const Tree::Digest& digest) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(2 * digest.size(), '0');
+    for (size_t i = 0; i < digest.size(); ++i) {
+        hex[2 * i] = digits[digest[i] >> 4];
+        hex[2 * i + 1] = digits[digest[i] & 0xF];
+    }
+    return hex;
+}
+
+// Reference root by the RFC 6962 recursion over the leaf digests
+Tree::Digest reference_root(const std::vector<Tree::Digest>& leaves, size_t first, size_t count) {
+    if (count == 1) return leaves[first];
+    size_t k = 1;
+    while (2 * k < count) k *= 2;
+    return Tree::node_digest(reference_root(leaves, first, k), reference_root(leaves, first + k, count - k));
+}
+
+template <typename Fn>
+double time_seconds(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    std::vector<uint8_t> data(64 << 20);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 2654435761u >> 13);
+    double megabytes = data.size() / 1e6;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Merkle tree hashing over " << data.size() / (1 << 20) << " MiB, "
+              << Tree::chunk_size / 1024 << " KiB leaves\n";
+
+    // Serial chain versus the tree on one and on every core
+    Tree::Digest chain, serial_root, parallel_root;
+    double chain_time = time_seconds([&] { chain = MerkleDamgardHash<64, 32>::hash(data.data(), data.size()); });
+    double serial_time = time_seconds([&] { serial_root = Tree::hash(data.data(), data.size(), 1); });
+    double parallel_time = time_seconds([&] { parallel_root = Tree::hash(data.data(), data.size(), cores); });
+    std::cout << "Merkle-Damgard chain: " << to_hex(chain) << " (" << megabytes / chain_time << " MB/s)\n";
+    std::cout << "Tree, 1 thread: " << to_hex(serial_root) << " (" << megabytes / serial_time << " MB/s)\n";
+    std::cout << "Tree, " << cores << " threads: " << to_hex(parallel_root) << " ("
+              << megabytes / parallel_time << " MB/s)\n";
+    bool ok = serial_root == parallel_root;
+
+    // Appends in uneven pieces: each root() matches hashing that prefix from scratch
+    Tree tree;
+    size_t appended = 0;
+    for (size_t piece = 1000; appended < data.size(); piece = piece * 5 + 12345) {
+        size_t take = std::min(piece, data.size() - appended);
+        tree.update(data.data() + appended, take);
+        appended += take;
+        ok = ok && tree.root() == Tree::hash(data.data(), appended);
+    }
+    std::cout << "Incremental roots match: " << (ok ? "yes" : "no") << " (" << tree.leaf_count() << " leaves)\n";
+
+    // And the spine fold matches the RFC 6962 recursion on a non-power-of-two leaf count
+    size_t length = 13 * Tree::chunk_size + 100;
+    std::vector<Tree::Digest> leaves;
+    for (size_t offset = 0; offset < length; offset += Tree::chunk_size) {
+        leaves.push_back(Tree::leaf_digest(data.data() + offset, std::min(Tree::chunk_size, length - offset)));
+    }
+    bool shape_ok = reference_root(leaves, 0, leaves.size()) == Tree::hash(data.data(), length);
+    std::cout << "Matches RFC 6962 tree shape: " << (shape_ok ? "yes" : "no") << "\n";
+
+    return ok && shape_ok ? 0 : 1;
+}
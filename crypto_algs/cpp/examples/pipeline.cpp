@@ -0,0 +1,73 @@
+#include <iostream>
+#include <array>
+#include <memory>
+#include <vector>
+#include <future>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "pipeline.hpp"
+
+using Pipeline = CryptoPipeline<1024>;
+
+template <typename Fn>
+double time_seconds(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    constexpr size_t SESSIONS = 256;
+    auto server_key = std::make_shared<const RsaPrivateKey<1024>>(generate_keypair<1024>());
+    const RsaPublicKey<1024> server_public = server_key->public_key();
+    MersenneTwister& random = thread_mersenne_twister();
+
+    // Clients: a 3DES session key wrapped under the server's public key, and
+    // a short CBC message under that session key
+    std::vector<std::array<uint64_t, 3>> session_keys(SESSIONS);
+    std::vector<BigInt<1024>> wrapped(SESSIONS);
+    std::vector<Pipeline::Bytes> plaintexts(SESSIONS), ciphertexts(SESSIONS);
+    const Pipeline::Iv iv = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (size_t i = 0; i < SESSIONS; ++i) {
+        std::array<uint64_t, 3>& k = session_keys[i];
+        k = {random.next_u64(), random.next_u64(), random.next_u64()};
+        BigInt<1024> packed;
+        for (size_t j = 0; j < 3; ++j) packed.limbs[j] = k[j];
+        wrapped[i] = mod_exp_vartime(packed, server_public.e, server_public.n_ctx);
+
+        plaintexts[i].resize(8 * (1 + i % 8));
+        random.fill(plaintexts[i].data(), plaintexts[i].size());
+        ciphertexts[i].resize(plaintexts[i].size());
+        Pipeline::Iv chain = iv;
+        tdes_encrypt_blocks(plaintexts[i].data(), ciphertexts[i].data(), ciphertexts[i].size() / 8,
+                            TripleDesKeySchedule(k[0], k[1], k[2]), Mode::CBC, chain.data());
+    }
+
+    // Server: unwrap every session key, then decrypt every message, all
+    // through one pipeline so both stages run in batches
+    bool ok = true;
+    Pipeline pipeline;
+    double seconds = time_seconds([&] {
+        std::vector<std::future<BigInt<1024>>> unwrapped;
+        for (const BigInt<1024>& c : wrapped) unwrapped.push_back(pipeline.rsa_decrypt(c, server_key));
+
+        std::vector<std::future<Pipeline::Bytes>> messages;
+        for (size_t i = 0; i < SESSIONS; ++i) {
+            BigInt<1024> packed = unwrapped[i].get();
+            auto schedule =
+                std::make_shared<const TripleDesKeySchedule>(packed.limbs[0], packed.limbs[1], packed.limbs[2]);
+            messages.push_back(pipeline.tdes_decrypt(ciphertexts[i], schedule, Mode::CBC, iv));
+        }
+        for (size_t i = 0; i < SESSIONS; ++i) ok &= messages[i].get() == plaintexts[i];
+    });
+
+    PipelineStats stats = pipeline.stats();
+    std::cout << SESSIONS << " sessions in " << seconds * 1e3 << " ms"
+              << " (engine " << des_engine_info().name << ")\n";
+    std::cout << "RSA: " << stats.rsa_operations << " decryptions in " << stats.rsa_batches << " batches\n";
+    std::cout << "3DES: " << stats.des_messages << " messages, " << stats.des_blocks << " blocks in "
+              << stats.des_batches << " batches (" << stats.deadline_batches << " batches started by the deadline)\n";
+    std::cout << (ok ? "All messages decrypted correctly\n" : "Mismatch!\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "rsa.hpp"
+
+// Function to format bytes as hex for display
+std::string to_hex(const uint8_t* bytes, size_t length) {
+    static const char digits[] = "0123456789ABCDEF";
+    std::string hex(2 * length, '0');
+    for (size_t i = 0; i < length; ++i) {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0xF];
+    }
+    return hex;
+}
+
+int main() {
+    using Int = BigInt<1024>;
+    using Prime = RsaPrivateKey<1024>::Half;
+
+    // Mersenne primes 2^61 - 1 and 2^89 - 1: n is far past what long long can hold
+    Prime p = Prime::from_string("2305843009213693951");
+    Prime q = Prime::from_string("618970019642690137449562111");
+
+    // Compute n, phi(n), e (starting at 17) and d, keeping p and q for the CRT
+    RsaPrivateKey<1024> key(p, q, 17);
+    Int phi = bigint_cast<1024>(p - 1) * bigint_cast<1024>(q - 1);
+
+    Int answer = mul_mod(key.e, key.d, phi);
+    std::cout << "e*d % phi = " << answer << "\n";
+    if (answer != Int(1)) {
+        std::cerr << "d is not the inverse of e mod phi.\n";
+        return 1;
+    }
+
+    // The constant-time inverse agrees with mod_inverse, down to a = 1 under an even modulus
+    if (mod_inverse_ct(key.e, phi) != mod_inverse(key.e, phi) || mod_inverse_ct(Int(1), Int(100)) != Int(1) ||
+        mod_inverse(Int(1), Int(100)) != Int(1)) {
+        std::cerr << "Constant-time inverse mismatch.\n";
+        return 1;
+    }
+
+    std::cout << "Public key: (" << key.e << ", " << key.n << ")\n";
+    std::cout << "Private key: (" << key.d << ", " << key.n << ")\n";
+
+    std::string message = "HELLO RSA!";
+    std::cout << "Original Message: " << message << "\n";
+
+    // Encrypt: c = m^e mod n
+    auto encrypted = encrypt_string(message, key.e, key.n);
+    std::cout << "Encrypted: ";
+    for (const auto& c : encrypted)
+        std::cout << c << " ";
+    std::cout << "\n";
+
+    // Decrypt: m = c^d mod n, via the CRT and directly
+    std::string decrypted = decrypt_string(encrypted, key);
+    std::cout << "Decrypted Message: " << decrypted << "\n";
+    if (decrypted != message || decrypted != decrypt_string(encrypted, key.d, key.n)) {
+        std::cerr << "CRT and direct decryption disagree.\n";
+        return 1;
+    }
+
+    // Block mode: the whole message is padded into modulus-sized blocks
+    std::vector<uint8_t> ciphertext;
+    RsaPublicKey<1024> public_key = key.public_key();
+    const uint8_t* message_bytes = reinterpret_cast<const uint8_t*>(message.data());
+    ciphertext.reserve(rsa_encrypted_size(message.size(), public_key));
+    rsa_encrypt_bytes(message_bytes, message.size(), public_key, ciphertext);
+    std::cout << "Block Encrypted (Hex): " << to_hex(ciphertext.data(), ciphertext.size()) << "\n";
+
+    std::vector<uint8_t> plaintext;
+    if (!rsa_decrypt_bytes(ciphertext.data(), ciphertext.size(), key, plaintext)) {
+        std::cerr << "Invalid padding after block decryption.\n";
+        return 1;
+    }
+    std::cout << "Block Decrypted: " << std::string(plaintext.begin(), plaintext.end()) << "\n";
+
+    // Batch verification: sign each character with d, verify all under e at once
+    std::vector<Int> digests, signatures;
+    for (char ch : message) {
+        digests.push_back(Int(static_cast<unsigned char>(ch)));
+        signatures.push_back(mod_exp(digests.back(), key.d, key.n));
+    }
+    std::unique_ptr<bool[]> valid(new bool[digests.size()]);
+    size_t verified = rsa_verify_batch(digests.data(), signatures.data(), digests.size(), public_key, valid.get());
+    std::cout << "Batch verified: " << verified << "/" << digests.size() << " signatures\n";
+    if (verified != digests.size()) {
+        std::cerr << "Batch verification rejected a valid signature.\n";
+        return 1;
+    }
+
+    // Fresh 1024-bit key from sieved Miller-Rabin search
+    RsaPrivateKey<1024> generated = generate_keypair<1024>();
+    std::cout << "Generated " << generated.n.bit_length() << "-bit modulus: " << generated.n << "\n";
+    ciphertext.clear();
+    plaintext.clear();
+    rsa_encrypt_bytes(message_bytes, message.size(), generated.public_key(), ciphertext);
+    if (!rsa_decrypt_bytes(ciphertext.data(), ciphertext.size(), generated, plaintext) ||
+        std::string(plaintext.begin(), plaintext.end()) != message) {
+        std::cerr << "Round trip failed under the generated key.\n";
+        return 1;
+    }
+    std::cout << "Generated key round trip: " << std::string(plaintext.begin(), plaintext.end()) << "\n";
+
+    // Fixed-base comb against the sliding window, for exponents up to the
+    // full 1024 bits (the comb grid then reaches past the top bit)
+    MontgomeryContext<1024> n_ctx(generated.n);
+    Int base = random_bits<1024>(1000);
+    Int all_ones;
+    for (uint64_t& limb : all_ones.limbs) limb = ~uint64_t(0);
+    std::vector<Int> exponents = {Int(1) << 1023, all_ones, random_bits<1024>(1024), random_bits<1024>(1020)};
+    exponents[2].limbs[15] |= uint64_t(1) << 63;
+    size_t comb_checks = 0;
+    for (size_t teeth = 1; teeth <= 6; ++teeth) {
+        FixedBaseExp<1024> comb(base, 1024, n_ctx, teeth);
+        for (const Int& exponent : exponents) {
+            if (comb.pow(exponent) != mod_exp(base, exponent, n_ctx)) {
+                std::cerr << "Comb mismatch with " << teeth << " teeth.\n";
+                return 1;
+            }
+            ++comb_checks;
+        }
+    }
+    std::cout << "Comb matched the sliding window: " << comb_checks << " full-width exponents\n";
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// --- Feistel Network ---
+// Generic balanced Feistel network, unrolled at compile time:
+//   (L, R) -> (R, L ^ F(R, k_i))   for i = 0 .. Rounds - 1
+// RoundFn supplies the round function as a static member
+//   static Half apply(Half half, RoundKey key);
+// plus the Half and RoundKey types. The rounds are expanded through an index
+// sequence, so there is no loop or call through a pointer left, and the key
+// order is a template argument: decryption is the same network with the keys
+// taken last to first, with the halves swapped on the way in and out.
+//
+// Instances: DES (des.hpp, 16 rounds over 32-bit halves) and the byte-pair
+// round of SimpleBlockCipher (davies_meyer.hpp, 1 round over bytes).
+
+template <typename RoundFn, size_t Rounds, typename HalfT = typename RoundFn::Half>
+struct Feistel {
+    static_assert(Rounds > 0, "a Feistel network needs at least one round");
+
+    using Half = HalfT;
+    using RoundKey = typename RoundFn::RoundKey;
+    static constexpr size_t rounds = Rounds;
+
+    // Function to run every round in place, keys first to last (or last to
+    // first with Reverse), without the final swap: (L0, R0) -> (Ln, Rn)
+    template <bool Reverse = false>
+    static constexpr void run(Half& left, Half& right, const RoundKey* round_keys) {
+        run_rounds<Reverse>(left, right, round_keys, std::make_index_sequence<Rounds>{});
+    }
+
+    static constexpr void encrypt(Half& left, Half& right, const RoundKey* round_keys) {
+        run<false>(left, right, round_keys);
+    }
+
+    // Inverse of encrypt with the same round keys
+    static constexpr void decrypt(Half& left, Half& right, const RoundKey* round_keys) {
+        run<true>(right, left, round_keys);
+    }
+
+private:
+    static constexpr void round(Half& left, Half& right, RoundKey round_key) {
+        Half next = static_cast<Half>(left ^ RoundFn::apply(right, round_key));
+        left = right;
+        right = next;
+    }
+
+    template <bool Reverse, size_t... I>
+    static constexpr void run_rounds(Half& left, Half& right, const RoundKey* round_keys,
+                                     std::index_sequence<I...>) {
+        (round(left, right, round_keys[Reverse ? Rounds - 1 - I : I]), ...);
+    }
+};
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+#include "des.hpp"
+#include "rsa.hpp"
+
+// --- Key Material Cache ---
+// Bounded, thread-safe map from key material to its prebuilt form: DES and
+// 3DES key schedules, and Montgomery contexts per modulus. Services that
+// interleave requests under many keys then pay a hash lookup per request
+// instead of a key expansion (or, for RSA, a long division for R^2 mod n).
+//
+// The cache is split into shards, each an LRU list under its own mutex, so
+// threads working under different keys rarely meet. Shards are picked by a
+// hash seeded per process, so key values cannot be chosen to pile into one
+// shard. Key material is held once (in the list entry; the index holds only
+// hashes). An evicted entry's key is wiped at once, and its value when the
+// last caller holding it lets go.
+
+// Function to overwrite memory in a way the compiler may not drop as dead
+inline void secure_zero(void* data, size_t length) {
+    volatile uint8_t* bytes = static_cast<volatile uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i) bytes[i] = 0;
+}
+
+// Per-process seed for the cache hashes
+inline uint64_t key_cache_seed() {
+    static const uint64_t seed = [] {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) | device();
+    }();
+    return seed;
+}
+
+// Seeded hash over the 64-bit words of a trivially copyable key (a
+// multiply-xorshift mix per word; not cryptographic, only spreading keys)
+template <typename Key>
+uint64_t key_material_hash(const Key& key) {
+    static_assert(std::is_trivially_copyable<Key>::value && sizeof(Key) % 8 == 0,
+                  "cache keys must be whole 64-bit words");
+    uint64_t hash = key_cache_seed();
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+    for (size_t i = 0; i < sizeof(Key); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
+    return hash ^ (hash >> 32);
+}
+
+template <typename Key, typename Value>
+class KeyCache {
+    static_assert(std::is_trivially_copyable<Value>::value, "cached values are wiped with secure_zero");
+
+public:
+    using Handle = std::shared_ptr<const Value>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static constexpr size_t DEFAULT_SHARDS = 16;
+
+    // capacity is the total entry count, spread evenly over the shards
+    explicit KeyCache(size_t capacity, size_t shard_count = DEFAULT_SHARDS)
+        : shards_(std::max<size_t>(shard_count, 1)) {
+        if (capacity == 0) throw std::invalid_argument("key cache capacity must be positive");
+        size_t per_shard = (capacity + shards_.size() - 1) / shards_.size();
+        for (Shard& shard : shards_) shard.capacity = per_shard;
+    }
+
+    KeyCache(const KeyCache&) = delete;
+    KeyCache& operator=(const KeyCache&) = delete;
+
+    ~KeyCache() { clear(); }
+
+    // Function to return the value for key, calling build(key) on a miss.
+    // build runs outside the shard lock; if two threads miss on the same key
+    // at once, the first to insert wins and the other copy is discarded.
+    template <typename Build>
+    Handle get(const Key& key, Build build) {
+        uint64_t hash = key_material_hash(key);
+        Shard& shard = shards_[hash % shards_.size()];
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            if (Handle found = shard.find(key, hash)) {
+                ++shard.stats.hits;
+                return found;
+            }
+            ++shard.stats.misses;
+        }
+
+        Handle built = make_handle(build(key));
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (Handle found = shard.find(key, hash)) return found;
+        shard.entries.push_front(Entry{key, hash, built});
+        shard.index.emplace(hash, shard.entries.begin());
+        if (shard.entries.size() > shard.capacity) shard.evict_last();
+        return built;
+    }
+
+    // Drops (and wipes the keys of) every entry
+    void clear() {
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            while (!shard.entries.empty()) shard.evict_last();
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            total += shard.entries.size();
+        }
+        return total;
+    }
+
+    Stats stats() const {
+        Stats total;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            total.hits += shard.stats.hits;
+            total.misses += shard.stats.misses;
+            total.evictions += shard.stats.evictions;
+        }
+        return total;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t hash;
+        Handle value;
+    };
+
+    struct Shard {
+        mutable std::mutex lock;
+        std::list<Entry> entries; // most recently used first
+        std::unordered_multimap<uint64_t, typename std::list<Entry>::iterator> index;
+        size_t capacity = 0;
+        Stats stats;
+
+        // Moves a hit to the front of the LRU list
+        Handle find(const Key& key, uint64_t hash) {
+            auto range = index.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second->key == key) {
+                    entries.splice(entries.begin(), entries, it->second);
+                    return it->second->value;
+                }
+            }
+            return nullptr;
+        }
+
+        void evict_last() {
+            auto last = std::prev(entries.end());
+            auto range = index.equal_range(last->hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == last) {
+                    index.erase(it);
+                    break;
+                }
+            }
+            secure_zero(&last->key, sizeof(Key));
+            entries.erase(last);
+            ++stats.evictions;
+        }
+    };
+
+    // The deleter wipes the value once the cache and every caller are done
+    // with it. The builder's temporary is copied to the heap and then wiped
+    // too, so the heap copy is the only one left.
+    static Handle make_handle(Value&& value) {
+        Handle handle(new Value(value), [](const Value* pointer) {
+            secure_zero(const_cast<Value*>(pointer), sizeof(Value));
+            delete pointer;
+        });
+        secure_zero(&value, sizeof(Value));
+        return handle;
+    }
+
+    std::vector<Shard> shards_;
+};
+
+// --- Standard Caches ---
+// Process-wide caches behind the cached_* helpers. Capacities are fixed at
+// first use; build a KeyCache directly for other sizes.
+
+inline constexpr size_t DEFAULT_SCHEDULE_CACHE_ENTRIES = 4096;
+inline constexpr size_t DEFAULT_CONTEXT_CACHE_ENTRIES = 1024;
+
+using DesScheduleCache = KeyCache<uint64_t, DesKeySchedule>;
+using TripleDesScheduleCache = KeyCache<std::array<uint64_t, 3>, TripleDesKeySchedule>;
+template <size_t Bits>
+using MontgomeryCache = KeyCache<BigInt<Bits>, MontgomeryContext<Bits>>;
+
+inline DesScheduleCache& des_schedule_cache() {
+    static DesScheduleCache cache(DEFAULT_SCHEDULE_CACHE_ENTRIES);
+    return cache;
+}
+
+inline TripleDesScheduleCache& tdes_schedule_cache() {
+    static TripleDesScheduleCache cache(DEFAULT_SCHEDULE_CACHE_ENTRIES);
+    return cache;
+}
+
+template <size_t Bits>
+MontgomeryCache<Bits>& montgomery_cache() {
+    static MontgomeryCache<Bits> cache(DEFAULT_CONTEXT_CACHE_ENTRIES);
+    return cache;
+}
+
+inline std::shared_ptr<const DesKeySchedule> cached_des_schedule(uint64_t key) {
+    return des_schedule_cache().get(key, [](uint64_t master_key) { return DesKeySchedule(master_key); });
+}
+
+inline std::shared_ptr<const TripleDesKeySchedule> cached_tdes_schedule(uint64_t key1, uint64_t key2, uint64_t key3) {
+    return tdes_schedule_cache().get({key1, key2, key3}, [](const std::array<uint64_t, 3>& keys) {
+        return TripleDesKeySchedule(keys[0], keys[1], keys[2]);
+    });
+}
+
+// Context for an odd modulus greater than 1 (RSA moduli and their primes)
+template <size_t Bits>
+std::shared_ptr<const MontgomeryContext<Bits>> cached_montgomery_context(const BigInt<Bits>& modulus) {
+    return montgomery_cache<Bits>().get(modulus, [](const BigInt<Bits>& n) { return MontgomeryContext<Bits>(n); });
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+// --- Merkle-Damgard Hash ---
+// Streaming counterpart of merkle_damgard.py: the same IV, compression
+// function and length padding, so digests match MerkleDamgardHash.hash().
+// Input is fed through update() in any number of pieces; only one partial
+// block is ever buffered and the padding is generated inside finalize(),
+// so memory use does not grow with the message.
+
+template <size_t BlockSize = 64, size_t OutputSize = 32>
+class MerkleDamgardHash {
+    static_assert(BlockSize > 8, "block must hold the 64-bit length field");
+    static_assert(OutputSize % 4 == 0, "IV is built from 4-byte words");
+
+public:
+    static constexpr size_t block_size = BlockSize;
+    static constexpr size_t output_size = OutputSize;
+    using Digest = std::array<uint8_t, OutputSize>;
+
+    MerkleDamgardHash() { reset(); }
+
+    // Function to restart with the initial value (IV)
+    void reset() {
+        static constexpr uint8_t IV_WORD[4] = {0x67, 0x45, 0x23, 0x01};
+        for (size_t i = 0; i < OutputSize; ++i) state_[i] = IV_WORD[i % 4];
+        buffered_ = 0;
+        total_length_ = 0;
+    }
+
+    // Function to absorb the next part of the message
+    void update(const uint8_t* data, size_t length) {
+        total_length_ += length;
+
+        // Top up a partial block first
+        if (buffered_ > 0) {
+            size_t take = std::min(length, BlockSize - buffered_);
+            std::memcpy(buffer_.data() + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            length -= take;
+            if (buffered_ < BlockSize) return;
+            compress(buffer_.data());
+            buffered_ = 0;
+        }
+
+        // Whole blocks straight from the caller's memory
+        for (; length >= BlockSize; data += BlockSize, length -= BlockSize) {
+            compress(data);
+        }
+
+        std::memcpy(buffer_.data(), data, length);
+        buffered_ = length;
+    }
+
+    void update(const std::string& data) {
+        update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+
+    // Function to pad (0x80, zeros, 64-bit big-endian bit length) and return
+    // the digest. The hasher is reset afterwards.
+    Digest finalize() {
+        uint64_t bit_length = total_length_ * 8;
+        buffer_[buffered_++] = 0x80;
+        if (buffered_ > BlockSize - 8) {
+            std::memset(buffer_.data() + buffered_, 0, BlockSize - buffered_);
+            compress(buffer_.data());
+            buffered_ = 0;
+        }
+        std::memset(buffer_.data() + buffered_, 0, BlockSize - 8 - buffered_);
+        for (int i = 0; i < 8; ++i) {
+            buffer_[BlockSize - 1 - i] = static_cast<uint8_t>(bit_length >> (8 * i));
+        }
+        compress(buffer_.data());
+
+        Digest digest = state_;
+        reset();
+        return digest;
+    }
+
+    // Function to hash a whole message in one call
+    static Digest hash(const uint8_t* data, size_t length) {
+        MerkleDamgardHash hasher;
+        hasher.update(data, length);
+        return hasher.finalize();
+    }
+
+    static Digest hash(const std::string& message) {
+        return hash(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    }
+
+private:
+    // Compression function: f(state, block) -> new_state, as in
+    // MerkleDamgardHash._compression_function
+    void compress(const uint8_t* block) {
+        uint8_t* result = state_.data();
+        for (size_t i = 0; i < OutputSize; ++i) {
+            uint8_t state_byte = result[i];
+            uint8_t block_byte = block[i % BlockSize];
+
+            // Simple mixing operations
+            uint8_t mixed = state_byte ^ block_byte;
+            mixed = static_cast<uint8_t>((mixed << 3) | (mixed >> 5)); // Rotate
+            result[i] = static_cast<uint8_t>(mixed + state_byte + block_byte);
+        }
+
+        // Additional mixing round, in place: result[i - 1] is already updated
+        uint8_t prev = result[OutputSize - 1];
+        for (size_t i = 0; i < OutputSize; ++i) {
+            uint8_t next = i + 1 < OutputSize ? result[i + 1] : result[0];
+            result[i] = static_cast<uint8_t>(result[i] ^ prev ^ next);
+            prev = result[i];
+        }
+    }
+
+    Digest state_;
+    std::array<uint8_t, BlockSize> buffer_;
+    size_t buffered_;
+    uint64_t total_length_;
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "merkle_damgard.hpp"
+
+// --- Merkle Tree Hashing ---
+// Tree mode over the Merkle-Damgard hash, so one large input is not held to
+// a single serial chain. The input is cut into ChunkSize leaves that are
+// hashed independently across threads, and the tree has the shape of
+// RFC 6962: for n > 1 leaves and k the largest power of two below n,
+//   root(D[0:n]) = H(0x01 || root(D[0:k]) || root(D[k:n])),  leaf = H(0x00 || chunk)
+// The prefixes keep leaf and interior digests apart. An empty input is one
+// empty leaf.
+//
+// That shape makes appends cheap: the complete leaves so far form perfect
+// subtrees of strictly decreasing size (the binary digits of the leaf
+// count), and only their roots are kept. Adding a leaf merges equal sizes
+// like a binary carry, and root() folds the O(log n) subtree roots along the
+// right spine together with the chunk still being filled.
+
+template <typename Hash = MerkleDamgardHash<>, size_t ChunkSize = 64 * 1024>
+class MerkleTreeHash {
+public:
+    using Digest = typename Hash::Digest;
+    static constexpr size_t chunk_size = ChunkSize;
+
+    // threads == 0 uses every core for runs of whole chunks
+    explicit MerkleTreeHash(unsigned threads = 0)
+        : threads_(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        reset();
+    }
+
+    // Function to start an empty tree
+    void reset() {
+        spine_.clear();
+        leaf_count_ = 0;
+        start_leaf();
+    }
+
+    // Function to append data; whole chunks within one call are hashed in parallel
+    void update(const uint8_t* data, size_t length) {
+        // Finish the chunk already in progress
+        if (leaf_fill_ > 0) {
+            size_t take = std::min(length, ChunkSize - leaf_fill_);
+            leaf_.update(data, take);
+            leaf_fill_ += take;
+            data += take;
+            length -= take;
+            if (leaf_fill_ < ChunkSize) return;
+            push_leaf(leaf_.finalize());
+            start_leaf();
+        }
+
+        // Whole chunks, a bounded batch at a time so the digests stay small
+        size_t whole = length / ChunkSize;
+        const size_t batch_limit = 16 * static_cast<size_t>(threads_);
+        std::vector<Digest> digests;
+        for (size_t first = 0; first < whole; first += batch_limit) {
+            size_t batch = std::min(batch_limit, whole - first);
+            const uint8_t* base = data + first * ChunkSize;
+            digests.resize(batch);
+            run_parallel(batch, [&](size_t i) { digests[i] = leaf_digest(base + i * ChunkSize, ChunkSize); });
+            for (const Digest& digest : digests) push_leaf(digest);
+        }
+        data += whole * ChunkSize;
+        length -= whole * ChunkSize;
+
+        leaf_.update(data, length);
+        leaf_fill_ += length;
+    }
+
+    // Function to compute the root of everything appended so far; the tree
+    // can keep growing afterwards
+    Digest root() const {
+        Digest acc;
+        bool have_acc = false;
+        if (leaf_fill_ > 0 || spine_.empty()) {
+            Hash open_leaf = leaf_;
+            acc = open_leaf.finalize();
+            have_acc = true;
+        }
+        for (size_t j = spine_.size(); j-- > 0;) {
+            acc = have_acc ? node_digest(spine_[j].digest, acc) : spine_[j].digest;
+            have_acc = true;
+        }
+        return acc;
+    }
+
+    // Number of leaves, counting a partly filled last chunk
+    uint64_t leaf_count() const { return leaf_count_ + (leaf_fill_ > 0 || leaf_count_ == 0 ? 1 : 0); }
+
+    static Digest leaf_digest(const uint8_t* chunk, size_t length) {
+        static constexpr uint8_t LEAF_PREFIX = 0x00;
+        Hash hasher;
+        hasher.update(&LEAF_PREFIX, 1);
+        hasher.update(chunk, length);
+        return hasher.finalize();
+    }
+
+    static Digest node_digest(const Digest& left, const Digest& right) {
+        static constexpr uint8_t NODE_PREFIX = 0x01;
+        Hash hasher;
+        hasher.update(&NODE_PREFIX, 1);
+        hasher.update(left.data(), left.size());
+        hasher.update(right.data(), right.size());
+        return hasher.finalize();
+    }
+
+    // Function to hash a whole buffer in one call
+    static Digest hash(const uint8_t* data, size_t length, unsigned threads = 0) {
+        MerkleTreeHash tree(threads);
+        tree.update(data, length);
+        return tree.root();
+    }
+
+private:
+    struct Subtree {
+        Digest digest;
+        uint64_t leaves;
+    };
+
+    void start_leaf() {
+        static constexpr uint8_t LEAF_PREFIX = 0x00;
+        leaf_.reset();
+        leaf_.update(&LEAF_PREFIX, 1);
+        leaf_fill_ = 0;
+    }
+
+    // Function to add a complete leaf, merging equal-sized subtrees
+    void push_leaf(const Digest& leaf) {
+        spine_.push_back({leaf, 1});
+        ++leaf_count_;
+        while (spine_.size() >= 2 && spine_[spine_.size() - 2].leaves == spine_.back().leaves) {
+            Subtree right = spine_.back();
+            spine_.pop_back();
+            spine_.back().digest = node_digest(spine_.back().digest, right.digest);
+            spine_.back().leaves += right.leaves;
+        }
+    }
+
+    // Function to run task(0 .. count-1) over the worker threads; the caller
+    // takes tasks too
+    template <typename Task>
+    void run_parallel(size_t count, Task task) const {
+        unsigned helpers = static_cast<unsigned>(std::min<size_t>(threads_, count)) - 1;
+        std::atomic<size_t> next{0};
+        auto worker = [&] {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) task(i);
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(helpers);
+        for (unsigned t = 0; t < helpers; ++t) pool.emplace_back(worker);
+        worker();
+        for (std::thread& thread : pool) thread.join();
+    }
+
+    std::vector<Subtree> spine_; // perfect subtrees, sizes strictly decreasing
+    Hash leaf_;                  // the chunk being filled, prefix already absorbed
+    size_t leaf_fill_;
+    uint64_t leaf_count_;        // complete leaves
+    unsigned threads_;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <random>
+
+// --- MT19937 Mersenne Twister ---
+// The generator of mersenne_twister.py, but regenerating the whole 624-word
+// state in one pass (split at the 397/227 wrap points so no index needs a
+// modulo and the loops vectorize) and serving bulk fill() requests straight
+// out of the state with the standard tempering applied. The output stream is
+// identical to std::mt19937 for the same seed.
+// Note: MT19937 is predictable from 624 outputs; it is not a CSPRNG.
+
+class MersenneTwister {
+public:
+    using result_type = uint32_t;
+    static constexpr size_t STATE_WORDS = 624;
+    static constexpr size_t SHIFT_WORDS = 397;
+    static constexpr uint32_t MATRIX_A = 0x9908B0DF;
+    static constexpr uint32_t DEFAULT_SEED = 5489;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFF; }
+
+    explicit MersenneTwister(uint32_t seed_value = DEFAULT_SEED) { seed(seed_value); }
+
+    // Seeds from several words
+    MersenneTwister(const uint32_t* key, size_t length) { seed(key, length); }
+
+    // Function to seed with one word (Knuth's linear congruential spread)
+    void seed(uint32_t value) {
+        state_[0] = value;
+        for (uint32_t i = 1; i < STATE_WORDS; ++i) {
+            state_[i] = 1812433253u * (state_[i - 1] ^ (state_[i - 1] >> 30)) + i;
+        }
+        index_ = STATE_WORDS;
+    }
+
+    // Function to seed from an array of words (reference init_by_array)
+    void seed(const uint32_t* key, size_t length) {
+        seed(19650218u);
+        size_t i = 1, j = 0;
+        for (size_t k = length > STATE_WORDS ? length : STATE_WORDS; k > 0; --k) {
+            state_[i] = (state_[i] ^ ((state_[i - 1] ^ (state_[i - 1] >> 30)) * 1664525u)) +
+                        key[j] + static_cast<uint32_t>(j);
+            if (++i >= STATE_WORDS) { state_[0] = state_[STATE_WORDS - 1]; i = 1; }
+            if (++j >= length) j = 0;
+        }
+        for (size_t k = STATE_WORDS - 1; k > 0; --k) {
+            state_[i] = (state_[i] ^ ((state_[i - 1] ^ (state_[i - 1] >> 30)) * 1566083941u)) -
+                        static_cast<uint32_t>(i);
+            if (++i >= STATE_WORDS) { state_[0] = state_[STATE_WORDS - 1]; i = 1; }
+        }
+        state_[0] = 0x80000000u;
+        index_ = STATE_WORDS;
+    }
+
+    // Function to seed from std::random_device
+    void seed_from_device() {
+        std::random_device device;
+        uint32_t key[8];
+        for (uint32_t& word : key) word = device();
+        seed(key, 8);
+    }
+
+    result_type operator()() {
+        if (index_ == STATE_WORDS) refill();
+        return temper(state_[index_++]);
+    }
+
+    uint64_t next_u64() {
+        uint64_t high = (*this)();
+        return (high << 32) | (*this)();
+    }
+
+    // Function to write length random bytes (tempered words, little-endian).
+    // A final partial word is consumed whole.
+    void fill(uint8_t* out, size_t length) {
+        while (length > 0) {
+            if (index_ == STATE_WORDS) refill();
+            size_t words = std::min(STATE_WORDS - index_, (length + 3) / 4);
+            size_t bytes = std::min(words * 4, length);
+            size_t whole = bytes / 4;
+
+            const uint32_t* source = state_ + index_;
+            for (size_t w = 0; w < whole; ++w) {
+                uint32_t value = temper(source[w]);
+                store_le32(out + 4 * w, value);
+            }
+            if (whole < words) {
+                uint8_t last[4];
+                store_le32(last, temper(source[whole]));
+                std::memcpy(out + 4 * whole, last, bytes - 4 * whole);
+            }
+            index_ += words;
+            out += bytes;
+            length -= bytes;
+        }
+    }
+
+private:
+    static uint32_t temper(uint32_t y) {
+        y ^= y >> 11;
+        y ^= (y << 7) & 0x9D2C5680u;
+        y ^= (y << 15) & 0xEFC60000u;
+        return y ^ (y >> 18);
+    }
+
+    static void store_le32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    // One twist step: upper bit of word i, lower bits of word i + 1
+    static uint32_t twist(uint32_t current, uint32_t next, uint32_t shifted) {
+        uint32_t y = (current & 0x80000000u) | (next & 0x7FFFFFFFu);
+        return shifted ^ (y >> 1) ^ ((0u - (y & 1u)) & MATRIX_A);
+    }
+
+    // Function to regenerate all 624 words. Word i reads i + 1 and i + 397;
+    // the first 227 words read only old values, the next 396 read words the
+    // first loop already replaced (227 back), and the last wraps to 0.
+    void refill() {
+        constexpr size_t SPLIT = STATE_WORDS - SHIFT_WORDS;
+        uint32_t* s = state_;
+        for (size_t i = 0; i < SPLIT; ++i) {
+            s[i] = twist(s[i], s[i + 1], s[i + SHIFT_WORDS]);
+        }
+        for (size_t i = SPLIT; i < STATE_WORDS - 1; ++i) {
+            s[i] = twist(s[i], s[i + 1], s[i - SPLIT]);
+        }
+        s[STATE_WORDS - 1] = twist(s[STATE_WORDS - 1], s[0], s[SHIFT_WORDS - 1]);
+        index_ = 0;
+    }
+
+    uint32_t state_[STATE_WORDS];
+    size_t index_;
+};
+
+// Per-thread generator seeded from std::random_device
+inline MersenneTwister& thread_mersenne_twister() {
+    thread_local MersenneTwister generator = [] {
+        MersenneTwister seeded;
+        seeded.seed_from_device();
+        return seeded;
+    }();
+    return generator;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// --- Instrumentation ---
+// Counters and scoped timers on the hot paths: DES key schedules, blocks
+// through the Feistel rounds and through each mode, bytes per thread, and
+// mod_exp calls with their squaring / multiply counts. Every thread adds to
+// its own slot block (plain relaxed stores, no shared cache lines or locked
+// instructions), and metrics_snapshot() sums the blocks on demand. Part of
+// libcryptoalgs; the thread registry lives in src/metrics.cpp.
+//
+// Both halves compile out unless enabled, at library build time, with the
+// CMake options CRYPTOALGS_ENABLE_METRICS (counters) and
+// CRYPTOALGS_ENABLE_TRACING (timers and the trace hook). Disabled, the
+// macros below expand to nothing and the snapshots read as zero.
+
+#ifndef CRYPTOALGS_ENABLE_METRICS
+#define CRYPTOALGS_ENABLE_METRICS 0
+#endif
+
+#ifndef CRYPTOALGS_ENABLE_TRACING
+#define CRYPTOALGS_ENABLE_TRACING 0
+#endif
+
+enum class Metric : size_t {
+    DesKeySchedules,  // generate_round_keys calls
+    DesBlocks,        // blocks through the 16 Feistel rounds (three per 3DES block)
+    EcbBlocks,        // blocks through each mode loop (3DES blocks count once)
+    CbcBlocks,
+    CtrBlocks,
+    ModeBytes,        // bytes through the mode loops
+    ModExpCalls,      // exponentiations, one per base in a batch
+    ModExpSquarings,
+    ModExpMultiplies, // multiplies by a power of the base, table builds included
+};
+
+inline constexpr size_t METRIC_COUNT = 9;
+
+enum class Timer : size_t {
+    KeySchedule, // generate_round_keys
+    DesBlocks,   // single-block calls and bit-sliced batches
+    ModExp,
+};
+
+inline constexpr size_t TIMER_COUNT = 3;
+
+// Stable names for export, e.g. "des_key_schedules"
+const char* metric_name(Metric metric);
+const char* timer_name(Timer timer);
+
+struct MetricsSnapshot {
+    uint64_t counters[METRIC_COUNT] = {};
+    uint64_t timer_calls[TIMER_COUNT] = {};
+    uint64_t timer_nanoseconds[TIMER_COUNT] = {};
+
+    uint64_t operator[](Metric metric) const { return counters[static_cast<size_t>(metric)]; }
+};
+
+struct ThreadMetrics {
+    std::thread::id thread;
+    MetricsSnapshot metrics;
+};
+
+// Totals over every thread, including threads that have exited
+MetricsSnapshot metrics_snapshot();
+
+// One entry per live thread that has recorded anything
+std::vector<ThreadMetrics> metrics_per_thread();
+
+// Zeroes every counter and timer. Counts racing with the reset on other
+// threads may survive it.
+void metrics_reset();
+
+// Called on every timed scope exit when tracing is enabled, with the start
+// on the steady clock and the duration. Must be thread-safe and cheap.
+using TraceHook = void (*)(Timer timer, uint64_t start_ns, uint64_t duration_ns);
+
+inline std::atomic<TraceHook> metrics_trace_hook{nullptr};
+
+inline void set_trace_hook(TraceHook hook) {
+    metrics_trace_hook.store(hook, std::memory_order_release);
+}
+
+// --- Per-Thread Slots ---
+
+struct MetricsSlots {
+    std::atomic<uint64_t> counters[METRIC_COUNT];
+    std::atomic<uint64_t> timer_calls[TIMER_COUNT];
+    std::atomic<uint64_t> timer_nanoseconds[TIMER_COUNT];
+};
+
+// Registers the calling thread's slots on its first count
+MetricsSlots& metrics_register_thread();
+
+inline thread_local MetricsSlots* metrics_local_slots = nullptr;
+
+inline MetricsSlots& metrics_slots() {
+    MetricsSlots* slots = metrics_local_slots;
+    return slots != nullptr ? *slots : metrics_register_thread();
+}
+
+// Only the owning thread writes its slots, so a load and a store suffice
+inline void metrics_bump(std::atomic<uint64_t>& slot, uint64_t amount) {
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline void metrics_add(Metric metric, uint64_t amount) {
+    metrics_bump(metrics_slots().counters[static_cast<size_t>(metric)], amount);
+}
+
+inline uint64_t steady_nanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Adds the lifetime of the scope to a timer
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer) : timer_(timer), start_(steady_nanoseconds()) {}
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        uint64_t duration = steady_nanoseconds() - start_;
+        MetricsSlots& slots = metrics_slots();
+        size_t index = static_cast<size_t>(timer_);
+        metrics_bump(slots.timer_calls[index], 1);
+        metrics_bump(slots.timer_nanoseconds[index], duration);
+        TraceHook hook = metrics_trace_hook.load(std::memory_order_acquire);
+        if (hook != nullptr) hook(timer_, start_, duration);
+    }
+
+private:
+    Timer timer_;
+    uint64_t start_;
+};
+
+// CRYPTOALGS_COUNT(DesBlocks, n) adds n to a counter; disabled, n is not
+// evaluated. CRYPTOALGS_TIME_SCOPE(ModExp) times the rest of the scope.
+#if CRYPTOALGS_ENABLE_METRICS
+#define CRYPTOALGS_COUNT(metric, amount) metrics_add(Metric::metric, (amount))
+#else
+#define CRYPTOALGS_COUNT(metric, amount) ((void)sizeof(amount))
+#endif
+
+#if CRYPTOALGS_ENABLE_TRACING
+#define CRYPTOALGS_TIME_SCOPE(timer) ScopedTimer scoped_timer_##timer(Timer::timer)
+#else
+#define CRYPTOALGS_TIME_SCOPE(timer) ((void)0)
+#endif
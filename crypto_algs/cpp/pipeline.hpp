@@ -0,0 +1,422 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "des.hpp"
+#include "rsa.hpp"
+
+// --- Batched Request Pipeline ---
+// Async front end for streams of small independent requests, such as RSA
+// unwraps of session keys followed by short DES / 3DES messages. Callers
+// submit and get a std::future back; a dispatcher thread holds requests
+// until a batch fills or the oldest one has waited max_delay, then runs the
+// whole batch at once:
+//   RSA   pending operations under the same key object (e.g. a KeyCache
+//         handle) go through rsa_decrypt_crt_batch / rsa_public_batch, so
+//         mod_exp_batch takes eight lanes at a time on IFMA.
+//   DES   the blocks of every pending message, under any mix of keys, modes
+//         and directions, go through des_process_blocks_keyed, so short
+//         messages fill bit-sliced passes together. CBC encryption chains,
+//         so those messages advance one block per step, side by side.
+// A full batch starts as soon as it is complete, so max_delay only bounds
+// the wait of requests that arrive too sparsely to fill one. Results and
+// exceptions come back through the futures; destroying the pipeline runs
+// whatever is still pending.
+
+struct PipelineOptions {
+    size_t rsa_batch = 8;                          // operations per key that start a batch at once
+    size_t des_batch_blocks = DES_MAX_PASS_BLOCKS; // pending DES blocks that start a batch at once
+    std::chrono::microseconds max_delay{200};      // longest a request waits for others
+};
+
+struct PipelineStats {
+    uint64_t rsa_batches = 0;
+    uint64_t rsa_operations = 0;
+    uint64_t des_batches = 0;
+    uint64_t des_messages = 0;
+    uint64_t des_blocks = 0;
+    uint64_t deadline_batches = 0; // batches started by max_delay rather than by size
+};
+
+template <size_t Bits>
+class CryptoPipeline {
+public:
+    using Clock = std::chrono::steady_clock;
+    using PrivateKey = std::shared_ptr<const RsaPrivateKey<Bits>>;
+    using PublicKey = std::shared_ptr<const RsaPublicKey<Bits>>;
+    using DesKey = std::shared_ptr<const DesKeySchedule>;
+    using TripleDesKey = std::shared_ptr<const TripleDesKeySchedule>;
+    using Bytes = std::vector<uint8_t>;
+    using Iv = std::array<uint8_t, 8>;
+
+    explicit CryptoPipeline(PipelineOptions options = {}) : options_(options) {
+        if (options_.rsa_batch == 0 || options_.des_batch_blocks == 0) {
+            throw std::invalid_argument("pipeline batch sizes must be positive");
+        }
+        dispatcher_ = std::thread([this] { dispatch(); });
+    }
+
+    CryptoPipeline(const CryptoPipeline&) = delete;
+    CryptoPipeline& operator=(const CryptoPipeline&) = delete;
+
+    ~CryptoPipeline() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        dispatcher_.join();
+    }
+
+    // m = c^d mod n through the CRT
+    std::future<BigInt<Bits>> rsa_decrypt(const BigInt<Bits>& c, PrivateKey key) {
+        return submit_rsa(private_queues_, c, std::move(key));
+    }
+
+    // m^e mod n: encryption, or recovering the digest from a signature
+    std::future<BigInt<Bits>> rsa_public(const BigInt<Bits>& m, PublicKey key) {
+        return submit_rsa(public_queues_, m, std::move(key));
+    }
+
+    // data must be a whole number of blocks (see pkcs7_pad). iv is the CBC
+    // chaining value or the CTR counter block; ECB ignores it.
+    std::future<Bytes> des_encrypt(Bytes data, DesKey key, Mode mode, const Iv& iv = {}) {
+        return submit_des(std::move(data), des_stages(key, mode, false), key, mode, false, iv);
+    }
+
+    std::future<Bytes> des_decrypt(Bytes data, DesKey key, Mode mode, const Iv& iv = {}) {
+        return submit_des(std::move(data), des_stages(key, mode, true), key, mode, true, iv);
+    }
+
+    std::future<Bytes> tdes_encrypt(Bytes data, TripleDesKey key, Mode mode, const Iv& iv = {}) {
+        return submit_des(std::move(data), tdes_stages(key, mode, false), key, mode, false, iv);
+    }
+
+    std::future<Bytes> tdes_decrypt(Bytes data, TripleDesKey key, Mode mode, const Iv& iv = {}) {
+        return submit_des(std::move(data), tdes_stages(key, mode, true), key, mode, true, iv);
+    }
+
+    // Starts every pending batch now instead of waiting for it to fill
+    void flush() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            flush_requested_ = true;
+        }
+        wake_.notify_one();
+    }
+
+    PipelineStats stats() const {
+        std::lock_guard<std::mutex> guard(lock_);
+        return stats_;
+    }
+
+private:
+    struct RsaJob {
+        BigInt<Bits> input;
+        std::promise<BigInt<Bits>> result;
+    };
+
+    // Pending operations under one key; deadline is that of the first job
+    template <typename Key>
+    struct RsaQueue {
+        Key key;
+        std::vector<RsaJob> jobs;
+        Clock::time_point deadline;
+    };
+
+    // Key and direction for each DES stage: one stage for DES, three for 3DES
+    struct DesStages {
+        std::array<DesLaneKey, 3> keys;
+        size_t count;
+    };
+
+    struct DesJob {
+        Bytes data; // transformed in place
+        DesStages stages;
+        Mode mode;
+        bool decrypt;
+        uint64_t iv;
+        std::shared_ptr<const void> key; // keeps the schedules behind stages alive
+        std::promise<Bytes> result;
+    };
+
+    // Everything the dispatcher took in one go
+    struct Batches {
+        std::vector<RsaQueue<PrivateKey>> private_ops;
+        std::vector<RsaQueue<PublicKey>> public_ops;
+        std::vector<DesJob> des_jobs;
+
+        bool empty() const { return private_ops.empty() && public_ops.empty() && des_jobs.empty(); }
+    };
+
+    // CTR only ever encrypts counter blocks, whichever way the data goes
+    static DesStages des_stages(const DesKey& key, Mode mode, bool decrypt) {
+        if (!key) throw std::invalid_argument("DES request needs a key schedule");
+        bool inverse = decrypt && mode != Mode::CTR;
+        return {{{{key.get(), inverse}}}, 1};
+    }
+
+    static DesStages tdes_stages(const TripleDesKey& key, Mode mode, bool decrypt) {
+        if (!key) throw std::invalid_argument("3DES request needs a key schedule");
+        if (decrypt && mode != Mode::CTR) {
+            return {{{{&key->k3, true}, {&key->k2, false}, {&key->k1, true}}}, 3};
+        }
+        return {{{{&key->k1, false}, {&key->k2, true}, {&key->k3, false}}}, 3};
+    }
+
+    template <typename Key>
+    std::future<BigInt<Bits>> submit_rsa(std::vector<RsaQueue<Key>>& queues, const BigInt<Bits>& input, Key key) {
+        if (!key) throw std::invalid_argument("RSA request needs a key");
+        RsaJob job{input, {}};
+        std::future<BigInt<Bits>> future = job.result.get_future();
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            auto queue = std::find_if(queues.begin(), queues.end(),
+                                      [&key](const RsaQueue<Key>& q) { return q.key == key; });
+            if (queue == queues.end()) {
+                queues.push_back(RsaQueue<Key>{std::move(key), {}, Clock::now() + options_.max_delay});
+                queue = queues.end() - 1;
+                wake = true; // a new deadline
+            }
+            queue->jobs.push_back(std::move(job));
+            wake |= queue->jobs.size() == options_.rsa_batch; // just filled
+        }
+        if (wake) wake_.notify_one();
+        return future;
+    }
+
+    std::future<Bytes> submit_des(Bytes data, const DesStages& stages, std::shared_ptr<const void> key,
+                                  Mode mode, bool decrypt, const Iv& iv) {
+        if (data.size() % 8 != 0) {
+            throw std::invalid_argument("DES message must be a whole number of 8-byte blocks");
+        }
+        size_t blocks = data.size() / 8;
+        DesJob job{std::move(data), stages, mode, decrypt, load_be64(iv.data()), std::move(key), {}};
+        std::future<Bytes> future = job.result.get_future();
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (des_jobs_.empty()) {
+                des_deadline_ = Clock::now() + options_.max_delay;
+                wake = true;
+            }
+            bool was_full = des_pending_blocks_ >= options_.des_batch_blocks;
+            des_jobs_.push_back(std::move(job));
+            des_pending_blocks_ += blocks;
+            wake |= !was_full && des_pending_blocks_ >= options_.des_batch_blocks;
+        }
+        if (wake) wake_.notify_one();
+        return future;
+    }
+
+    // --- Dispatcher ---
+
+    void dispatch() {
+        std::unique_lock<std::mutex> lock(lock_);
+        for (;;) {
+            Batches batches = take_ready(Clock::now());
+            if (batches.empty()) {
+                if (stopping_) return;
+                Clock::time_point deadline = next_deadline();
+                if (deadline == Clock::time_point::max()) {
+                    wake_.wait(lock);
+                } else {
+                    wake_.wait_until(lock, deadline);
+                }
+                continue;
+            }
+            lock.unlock();
+            run(batches);
+            lock.lock();
+        }
+    }
+
+    // Moves every batch that is full or due out of the queues (all of them
+    // on flush or shutdown). Called with lock_ held.
+    Batches take_ready(Clock::time_point now) {
+        bool take_all = stopping_ || flush_requested_;
+        flush_requested_ = false;
+        Batches batches;
+        take_ready_rsa(private_queues_, batches.private_ops, now, take_all);
+        take_ready_rsa(public_queues_, batches.public_ops, now, take_all);
+
+        bool full = des_pending_blocks_ >= options_.des_batch_blocks;
+        if (!des_jobs_.empty() && (take_all || full || des_deadline_ <= now)) {
+            if (!take_all && !full) ++stats_.deadline_batches;
+            ++stats_.des_batches;
+            stats_.des_messages += des_jobs_.size();
+            stats_.des_blocks += des_pending_blocks_;
+            batches.des_jobs.swap(des_jobs_);
+            des_pending_blocks_ = 0;
+        }
+        return batches;
+    }
+
+    template <typename Key>
+    void take_ready_rsa(std::vector<RsaQueue<Key>>& queues, std::vector<RsaQueue<Key>>& taken,
+                        Clock::time_point now, bool take_all) {
+        for (size_t i = 0; i < queues.size();) {
+            bool full = queues[i].jobs.size() >= options_.rsa_batch;
+            if (!take_all && !full && queues[i].deadline > now) {
+                ++i;
+                continue;
+            }
+            if (!take_all && !full) ++stats_.deadline_batches;
+            ++stats_.rsa_batches;
+            stats_.rsa_operations += queues[i].jobs.size();
+            taken.push_back(std::move(queues[i]));
+            queues[i] = std::move(queues.back());
+            queues.pop_back();
+        }
+    }
+
+    Clock::time_point next_deadline() const {
+        Clock::time_point deadline = Clock::time_point::max();
+        for (const auto& queue : private_queues_) deadline = std::min(deadline, queue.deadline);
+        for (const auto& queue : public_queues_) deadline = std::min(deadline, queue.deadline);
+        if (!des_jobs_.empty()) deadline = std::min(deadline, des_deadline_);
+        return deadline;
+    }
+
+    void run(Batches& batches) {
+        for (auto& queue : batches.private_ops) {
+            run_rsa(queue, [&queue](const BigInt<Bits>* in, BigInt<Bits>* out, size_t count) {
+                rsa_decrypt_crt_batch(in, out, count, *queue.key);
+            });
+        }
+        for (auto& queue : batches.public_ops) {
+            run_rsa(queue, [&queue](const BigInt<Bits>* in, BigInt<Bits>* out, size_t count) {
+                rsa_public_batch(in, out, count, *queue.key);
+            });
+        }
+        if (!batches.des_jobs.empty()) run_des(batches.des_jobs);
+    }
+
+    // --- Batch Execution ---
+
+    template <typename Key, typename BatchFn>
+    static void run_rsa(RsaQueue<Key>& queue, BatchFn batch_fn) {
+        std::vector<RsaJob>& jobs = queue.jobs;
+        try {
+            std::vector<BigInt<Bits>> values(jobs.size());
+            for (size_t i = 0; i < jobs.size(); ++i) values[i] = jobs[i].input;
+            batch_fn(values.data(), values.data(), values.size());
+            for (size_t i = 0; i < jobs.size(); ++i) jobs[i].result.set_value(values[i]);
+        } catch (...) {
+            for (RsaJob& job : jobs) job.result.set_exception(std::current_exception());
+        }
+    }
+
+    // DES and 3DES messages run as separate lane sets, since they differ in
+    // the number of stages
+    static void run_des(std::vector<DesJob>& jobs) {
+        try {
+            std::vector<DesJob*> single, triple;
+            for (DesJob& job : jobs) (job.stages.count == 1 ? single : triple).push_back(&job);
+            run_des_lanes(single, 1);
+            run_des_lanes(triple, 3);
+        } catch (...) {
+            for (DesJob& job : jobs) job.result.set_exception(std::current_exception());
+            return;
+        }
+        for (DesJob& job : jobs) job.result.set_value(std::move(job.data));
+    }
+
+    // Runs words through every stage, word i under its job's keys
+    static void run_stages(std::vector<uint64_t>& words, const std::vector<DesJob*>& owners, size_t stage_count) {
+        std::vector<DesLaneKey> keys(words.size());
+        for (size_t stage = 0; stage < stage_count; ++stage) {
+            for (size_t i = 0; i < words.size(); ++i) keys[i] = owners[i]->stages.keys[stage];
+            des_process_blocks_keyed(words.data(), words.data(), words.size(), keys.data());
+        }
+    }
+
+    static void run_des_lanes(const std::vector<DesJob*>& jobs, size_t stage_count) {
+        if (jobs.empty()) return;
+
+        // ECB, CTR and CBC decryption: every block of every message in one batch
+        size_t total = 0;
+        for (DesJob* job : jobs) total += job->data.size() / 8;
+        std::vector<uint64_t> words;
+        std::vector<DesJob*> owners;
+        std::vector<DesJob*> chained;
+        words.reserve(total);
+        owners.reserve(total);
+        for (DesJob* job : jobs) {
+            if (job->mode == Mode::CBC && !job->decrypt) {
+                chained.push_back(job);
+                continue;
+            }
+            size_t blocks = job->data.size() / 8;
+            for (size_t i = 0; i < blocks; ++i) {
+                words.push_back(job->mode == Mode::CTR ? job->iv + i : load_be64(&job->data[8 * i]));
+                owners.push_back(job);
+            }
+        }
+        run_stages(words, owners, stage_count);
+        size_t next = 0;
+        for (DesJob* job : jobs) {
+            if (job->mode == Mode::CBC && !job->decrypt) continue;
+            uint64_t chain = job->iv;
+            for (size_t i = 0; i < job->data.size() / 8; ++i, ++next) {
+                uint8_t* block = &job->data[8 * i];
+                if (job->mode == Mode::ECB) {
+                    store_be64(block, words[next]);
+                } else if (job->mode == Mode::CTR) {
+                    store_be64(block, load_be64(block) ^ words[next]);
+                } else {
+                    uint64_t ciphertext = load_be64(block);
+                    store_be64(block, words[next] ^ chain);
+                    chain = ciphertext;
+                }
+            }
+        }
+
+        // CBC encryption: block t of every message that long, one step at a time
+        std::vector<uint64_t> chains;
+        for (DesJob* job : chained) chains.push_back(job->iv);
+        for (size_t t = 0;; ++t) {
+            words.clear();
+            owners.clear();
+            for (size_t j = 0; j < chained.size(); ++j) {
+                if (8 * t >= chained[j]->data.size()) continue;
+                words.push_back(load_be64(&chained[j]->data[8 * t]) ^ chains[j]);
+                owners.push_back(chained[j]);
+            }
+            if (words.empty()) break;
+            run_stages(words, owners, stage_count);
+            size_t lane = 0;
+            for (size_t j = 0; j < chained.size(); ++j) {
+                if (8 * t >= chained[j]->data.size()) continue;
+                chains[j] = words[lane++];
+                store_be64(&chained[j]->data[8 * t], chains[j]);
+            }
+        }
+    }
+
+    PipelineOptions options_;
+    mutable std::mutex lock_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    bool flush_requested_ = false;
+    std::vector<RsaQueue<PrivateKey>> private_queues_;
+    std::vector<RsaQueue<PublicKey>> public_queues_;
+    std::vector<DesJob> des_jobs_;
+    size_t des_pending_blocks_ = 0;
+    Clock::time_point des_deadline_;
+    PipelineStats stats_;
+    std::thread dispatcher_;
+};
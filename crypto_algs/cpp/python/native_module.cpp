@@ -0,0 +1,523 @@
+// --- crypto_algs._native ---
+// CPython extension exposing the C++ DES, hash and RSA cores to the Python
+// modules. Byte arguments take any buffer-protocol object (bytes, bytearray,
+// memoryview, mmap, numpy arrays) and are read in place; each result is
+// written straight into a freshly allocated bytes object. Bulk calls run
+// with the GIL released, so Python threads can hash or encrypt in parallel.
+//
+// Written against the plain C API (no pybind11 / nanobind): the functions
+// are few and flat, and this keeps the build down to Python's own headers.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "davies_meyer.hpp"
+#include "des.hpp"
+#include "key_cache.hpp"
+#include "merkle_damgard.hpp"
+#include "merkle_tree.hpp"
+#include "metrics.hpp"
+#include "rsa.hpp"
+
+namespace {
+
+// --- Buffers and Errors ---
+
+// Read-only view of a buffer argument, released on scope exit
+class BufferView {
+public:
+    BufferView() : view_{}, held_(false) {}
+    ~BufferView() { if (held_) PyBuffer_Release(&view_); }
+    BufferView(const BufferView&) = delete;
+    BufferView& operator=(const BufferView&) = delete;
+
+    bool acquire(PyObject* object) {
+        if (PyObject_GetBuffer(object, &view_, PyBUF_SIMPLE) != 0) return false;
+        held_ = true;
+        return true;
+    }
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(view_.buf); }
+    size_t size() const { return static_cast<size_t>(view_.len); }
+
+private:
+    Py_buffer view_;
+    bool held_;
+};
+
+// Uninitialized bytes object of the given size; nullptr with an error set
+inline PyObject* new_bytes(size_t size) {
+    return PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size));
+}
+
+inline uint8_t* bytes_data(PyObject* bytes) {
+    return reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(bytes));
+}
+
+// Runs work with the GIL released. Returns false (with a Python error set)
+// if it threw.
+template <typename Work>
+bool run_without_gil(Work work) {
+    std::string message;
+    int kind = 0; // 0 ok, 1 ValueError, 2 OverflowError, 3 MemoryError, 4 RuntimeError
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        work();
+    } catch (const std::invalid_argument& error) {
+        kind = 1, message = error.what();
+    } catch (const std::overflow_error& error) {
+        kind = 2, message = error.what();
+    } catch (const std::bad_alloc&) {
+        kind = 3;
+    } catch (const std::exception& error) {
+        kind = 4, message = error.what();
+    }
+    Py_END_ALLOW_THREADS
+    switch (kind) {
+        case 0: return true;
+        case 1: PyErr_SetString(PyExc_ValueError, message.c_str()); break;
+        case 2: PyErr_SetString(PyExc_OverflowError, message.c_str()); break;
+        case 3: PyErr_NoMemory(); break;
+        default: PyErr_SetString(PyExc_RuntimeError, message.c_str()); break;
+    }
+    return false;
+}
+
+// --- DES / Triple DES ---
+// An 8-byte key selects single DES; 16 bytes two-key 3DES (K3 = K1) and
+// 24 bytes three-key 3DES, the key layouts of cryptography's TripleDES.
+
+inline void encrypt_blocks(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    des_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void encrypt_blocks(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    tdes_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void decrypt_blocks(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    des_decrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void decrypt_blocks(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    tdes_decrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void ctr_parallel(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                         uint8_t* counter, unsigned threads) {
+    des_ctr_parallel(in, out, nblocks, schedule, counter, threads);
+}
+
+inline void ctr_parallel(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                         uint8_t* counter, unsigned threads) {
+    tdes_ctr_parallel(in, out, nblocks, schedule, counter, threads);
+}
+
+inline void cbc_decrypt_parallel(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                                 uint8_t* iv, unsigned threads) {
+    des_cbc_decrypt_parallel(in, out, nblocks, schedule, iv, threads);
+}
+
+inline void cbc_decrypt_parallel(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out,
+                                 size_t nblocks, uint8_t* iv, unsigned threads) {
+    tdes_cbc_decrypt_parallel(in, out, nblocks, schedule, iv, threads);
+}
+
+inline void ctr_offset(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t length,
+                       const uint8_t* nonce) {
+    des_ctr_offset(in, out, length, schedule, nonce);
+}
+
+inline void ctr_offset(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t length,
+                       const uint8_t* nonce) {
+    tdes_ctr_offset(in, out, length, schedule, nonce);
+}
+
+// ECB / CBC need whole blocks; CTR takes any length, the final partial
+// block using the leading bytes of its keystream block
+template <typename Schedule>
+void crypt_buffer(const Schedule& schedule, bool decrypt, Mode mode, const uint8_t* in, uint8_t* out,
+                  size_t length, uint8_t* iv, unsigned threads) {
+    size_t whole = length / 8;
+    if (mode == Mode::CTR) {
+        ctr_parallel(schedule, in, out, whole, iv, threads);
+        size_t tail = length % 8;
+        if (tail != 0) {
+            uint8_t keystream[8];
+            encrypt_blocks(schedule, iv, keystream, 1, Mode::ECB, nullptr);
+            for (size_t b = 0; b < tail; ++b) out[8 * whole + b] = in[8 * whole + b] ^ keystream[b];
+        }
+    } else if (decrypt && mode == Mode::CBC) {
+        cbc_decrypt_parallel(schedule, in, out, whole, iv, threads);
+    } else if (decrypt) {
+        decrypt_blocks(schedule, in, out, whole, mode, iv);
+    } else {
+        encrypt_blocks(schedule, in, out, whole, mode, iv);
+    }
+}
+
+// Calls work(schedule) with the DES or 3DES schedule for the key bytes,
+// from the process-wide schedule caches (key_cache.hpp)
+template <typename Work>
+void with_schedule(const uint8_t* key, size_t key_size, Work work) {
+    if (key_size == 8) {
+        work(*cached_des_schedule(load_be64(key)));
+    } else if (key_size == 16 || key_size == 24) {
+        work(*cached_tdes_schedule(load_be64(key), load_be64(key + 8), load_be64(key_size == 24 ? key + 16 : key)));
+    } else {
+        throw std::invalid_argument("DES key must be 8 bytes (DES) or 16 / 24 bytes (3DES)");
+    }
+}
+
+inline bool parse_mode(const char* name, Mode& mode) {
+    if (std::strcmp(name, "ECB") == 0) mode = Mode::ECB;
+    else if (std::strcmp(name, "CBC") == 0) mode = Mode::CBC;
+    else if (std::strcmp(name, "CTR") == 0) mode = Mode::CTR;
+    else return false;
+    return true;
+}
+
+PyObject* des_crypt(PyObject* args, PyObject* kwargs, bool decrypt) {
+    static const char* keywords[] = {"key", "data", "mode", "iv", "threads", nullptr};
+    PyObject* key_object;
+    PyObject* data_object;
+    const char* mode_name = "CBC";
+    PyObject* iv_object = Py_None;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|sOI", const_cast<char**>(keywords), &key_object,
+                                     &data_object, &mode_name, &iv_object, &threads)) {
+        return nullptr;
+    }
+
+    Mode mode;
+    if (!parse_mode(mode_name, mode)) {
+        PyErr_Format(PyExc_ValueError, "unsupported mode %s (ECB, CBC or CTR)", mode_name);
+        return nullptr;
+    }
+    BufferView key, data, iv_view;
+    if (!key.acquire(key_object) || !data.acquire(data_object)) return nullptr;
+    uint8_t iv[8] = {};
+    if (mode != Mode::ECB) {
+        if (iv_object == Py_None || !iv_view.acquire(iv_object)) {
+            if (!PyErr_Occurred()) PyErr_Format(PyExc_ValueError, "%s requires an 8-byte iv", mode_name);
+            return nullptr;
+        }
+        if (iv_view.size() != 8) {
+            PyErr_Format(PyExc_ValueError, "%s requires an 8-byte iv", mode_name);
+            return nullptr;
+        }
+        std::memcpy(iv, iv_view.data(), 8);
+    }
+    if (mode != Mode::CTR && data.size() % 8 != 0) {
+        PyErr_Format(PyExc_ValueError, "%s data must be a multiple of 8 bytes (pad it first)", mode_name);
+        return nullptr;
+    }
+
+    PyObject* result = new_bytes(data.size());
+    if (result == nullptr) return nullptr;
+    uint8_t* out = bytes_data(result);
+    bool ok = run_without_gil([&] {
+        with_schedule(key.data(), key.size(), [&](const auto& schedule) {
+            crypt_buffer(schedule, decrypt, mode, data.data(), out, data.size(), iv, threads);
+        });
+    });
+    if (!ok) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+    return result;
+}
+
+PyObject* py_des_encrypt(PyObject*, PyObject* args, PyObject* kwargs) {
+    return des_crypt(args, kwargs, false);
+}
+
+PyObject* py_des_decrypt(PyObject*, PyObject* args, PyObject* kwargs) {
+    return des_crypt(args, kwargs, true);
+}
+
+PyObject* py_des_ctr_offset(PyObject*, PyObject* args) {
+    PyObject* key_object;
+    PyObject* nonce_object;
+    PyObject* data_object;
+    if (!PyArg_ParseTuple(args, "OOO", &key_object, &nonce_object, &data_object)) return nullptr;
+
+    BufferView key, nonce, data;
+    if (!key.acquire(key_object) || !nonce.acquire(nonce_object) || !data.acquire(data_object)) return nullptr;
+    if (nonce.size() != 8) {
+        PyErr_SetString(PyExc_ValueError, "nonce must be 8 bytes");
+        return nullptr;
+    }
+
+    PyObject* result = new_bytes(data.size());
+    if (result == nullptr) return nullptr;
+    uint8_t* out = bytes_data(result);
+    bool ok = run_without_gil([&] {
+        with_schedule(key.data(), key.size(), [&](const auto& schedule) {
+            ctr_offset(schedule, data.data(), out, data.size(), nonce.data());
+        });
+    });
+    if (!ok) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+    return result;
+}
+
+PyObject* py_des_engine(PyObject*, PyObject*) {
+    return PyUnicode_FromString(des_engine_info().name);
+}
+
+// --- Hashes ---
+
+// Hashes one buffer argument with hash_fn(data, size) -> digest array
+template <typename HashFn>
+PyObject* hash_buffer(PyObject* data_object, HashFn hash_fn) {
+    BufferView data;
+    if (!data.acquire(data_object)) return nullptr;
+    decltype(hash_fn(data.data(), data.size())) digest{};
+    if (!run_without_gil([&] { digest = hash_fn(data.data(), data.size()); })) return nullptr;
+    return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(digest.data()),
+                                     static_cast<Py_ssize_t>(digest.size()));
+}
+
+PyObject* py_davies_meyer_des(PyObject*, PyObject* data_object) {
+    return hash_buffer(data_object, [](const uint8_t* data, size_t size) { return DaviesMeyerDes::hash(data, size); });
+}
+
+PyObject* py_merkle_damgard(PyObject*, PyObject* data_object) {
+    return hash_buffer(data_object, [](const uint8_t* data, size_t size) {
+        return MerkleDamgardHash<>::hash(data, size);
+    });
+}
+
+PyObject* py_merkle_tree(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"data", "threads", nullptr};
+    PyObject* data_object;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|I", const_cast<char**>(keywords), &data_object, &threads)) {
+        return nullptr;
+    }
+    return hash_buffer(data_object, [threads](const uint8_t* data, size_t size) {
+        return MerkleTreeHash<>::hash(data, size, threads);
+    });
+}
+
+// Same result as utils.xor_bytes: the length of the shorter input
+PyObject* py_xor_bytes(PyObject*, PyObject* args) {
+    PyObject* first_object;
+    PyObject* second_object;
+    if (!PyArg_ParseTuple(args, "OO", &first_object, &second_object)) return nullptr;
+    BufferView first, second;
+    if (!first.acquire(first_object) || !second.acquire(second_object)) return nullptr;
+
+    size_t length = std::min(first.size(), second.size());
+    PyObject* result = new_bytes(length);
+    if (result == nullptr) return nullptr;
+    uint8_t* out = bytes_data(result);
+    Py_BEGIN_ALLOW_THREADS
+    for (size_t i = 0; i < length; ++i) out[i] = first.data()[i] ^ second.data()[i];
+    Py_END_ALLOW_THREADS
+    return result;
+}
+
+// --- RSA ---
+// Python ints cross as big-endian bytes (int.to_bytes / int.from_bytes).
+// Each call runs at the smallest library width that holds its operands.
+
+// Big-endian bytes of a non-negative int; false with an error set otherwise
+bool int_to_bytes(PyObject* value, std::vector<uint8_t>& bytes) {
+    if (!PyLong_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "expected an int");
+        return false;
+    }
+    PyObject* zero = PyLong_FromLong(0);
+    int negative = zero != nullptr ? PyObject_RichCompareBool(value, zero, Py_LT) : -1;
+    Py_XDECREF(zero);
+    if (negative != 0) {
+        if (negative == 1) PyErr_SetString(PyExc_ValueError, "expected a non-negative int");
+        return false;
+    }
+    PyObject* bit_length = PyObject_CallMethod(value, "bit_length", nullptr);
+    if (bit_length == nullptr) return false;
+    size_t length = (PyLong_AsSize_t(bit_length) + 7) / 8;
+    Py_DECREF(bit_length);
+    if (PyErr_Occurred()) return false;
+
+    PyObject* encoded = PyObject_CallMethod(value, "to_bytes", "ns", static_cast<Py_ssize_t>(length), "big");
+    if (encoded == nullptr) return false;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(PyBytes_AS_STRING(encoded));
+    bytes.assign(data, data + length);
+    Py_DECREF(encoded);
+    return true;
+}
+
+template <size_t Bits>
+PyObject* bigint_to_int(const BigInt<Bits>& value) {
+    uint8_t bytes[Bits / 8];
+    value.to_bytes(bytes, sizeof(bytes));
+    return PyObject_CallMethod(reinterpret_cast<PyObject*>(&PyLong_Type), "from_bytes", "y#s",
+                               reinterpret_cast<const char*>(bytes), static_cast<Py_ssize_t>(sizeof(bytes)), "big");
+}
+
+template <size_t Bits>
+BigInt<Bits> bigint_from(const std::vector<uint8_t>& bytes) {
+    return BigInt<Bits>::from_bytes(bytes.data(), bytes.size());
+}
+
+template <size_t Bits>
+PyObject* mod_exp_at(const std::vector<uint8_t>& base, const std::vector<uint8_t>& exp,
+                     const std::vector<uint8_t>& mod) {
+    BigInt<Bits> result;
+    bool ok = run_without_gil([&] {
+        BigInt<Bits> modulus = bigint_from<Bits>(mod);
+        if (modulus.is_odd() && modulus != BigInt<Bits>(1)) {
+            // Odd moduli repeat across calls (RSA keys): reuse their Montgomery contexts
+            result = mod_exp(bigint_from<Bits>(base), bigint_from<Bits>(exp), *cached_montgomery_context(modulus));
+        } else {
+            result = mod_exp(bigint_from<Bits>(base), bigint_from<Bits>(exp), modulus);
+        }
+    });
+    if (!ok) return nullptr;
+    return bigint_to_int(result);
+}
+
+PyObject* py_rsa_mod_exp(PyObject*, PyObject* args) {
+    PyObject* base_object;
+    PyObject* exp_object;
+    PyObject* mod_object;
+    if (!PyArg_ParseTuple(args, "OOO", &base_object, &exp_object, &mod_object)) return nullptr;
+
+    std::vector<uint8_t> base, exp, mod;
+    if (!int_to_bytes(base_object, base) || !int_to_bytes(exp_object, exp) || !int_to_bytes(mod_object, mod)) {
+        return nullptr;
+    }
+    if (mod.empty()) {
+        PyErr_SetString(PyExc_ZeroDivisionError, "modulus is zero");
+        return nullptr;
+    }
+    // The base is reduced by the library, but has to fit the width first
+    size_t width = std::max({base.size(), exp.size(), mod.size()});
+    if (width <= 1024 / 8) return mod_exp_at<1024>(base, exp, mod);
+    if (width <= 2048 / 8) return mod_exp_at<2048>(base, exp, mod);
+    if (width <= 4096 / 8) return mod_exp_at<4096>(base, exp, mod);
+    PyErr_SetString(PyExc_OverflowError, "operands wider than 4096 bits");
+    return nullptr;
+}
+
+template <size_t Bits>
+PyObject* keypair_tuple(const RsaPrivateKey<Bits>& key) {
+    return Py_BuildValue("(NNNNN)", bigint_to_int(key.n), bigint_to_int(key.e), bigint_to_int(key.d),
+                         bigint_to_int(key.p), bigint_to_int(key.q));
+}
+
+template <size_t Bits>
+PyObject* generate_at(size_t bits, unsigned threads) {
+    std::optional<RsaPrivateKey<Bits>> key;
+    if (!run_without_gil([&] { key.emplace(generate_keypair<Bits>(bits, threads)); })) return nullptr;
+    return keypair_tuple(*key);
+}
+
+PyObject* py_rsa_generate_keypair(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"bits", "threads", nullptr};
+    Py_ssize_t bits = 2048;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nI", const_cast<char**>(keywords), &bits, &threads)) {
+        return nullptr;
+    }
+    if (bits <= 0) bits = 1; // rejected by generate_keypair
+    size_t width = static_cast<size_t>(bits);
+    if (width <= 1024) return generate_at<1024>(width, threads);
+    if (width <= 2048) return generate_at<2048>(width, threads);
+    if (width <= 4096) return generate_at<4096>(width, threads);
+    PyErr_SetString(PyExc_ValueError, "RSA key size must be at most 4096 bits");
+    return nullptr;
+}
+
+// --- Metrics ---
+
+// {"des_blocks": n, ..., "mod_exp_ns": t, "mod_exp_timed": calls, ...}; all
+// zero unless the library was built with the instrumentation options
+PyObject* py_metrics(PyObject*, PyObject*) {
+    MetricsSnapshot snapshot = metrics_snapshot();
+    PyObject* result = PyDict_New();
+    if (result == nullptr) return nullptr;
+    auto put = [result](const std::string& name, uint64_t value) {
+        PyObject* number = PyLong_FromUnsignedLongLong(value);
+        bool ok = number != nullptr && PyDict_SetItemString(result, name.c_str(), number) == 0;
+        Py_XDECREF(number);
+        return ok;
+    };
+    bool ok = true;
+    for (size_t i = 0; ok && i < METRIC_COUNT; ++i) {
+        ok = put(metric_name(static_cast<Metric>(i)), snapshot.counters[i]);
+    }
+    for (size_t i = 0; ok && i < TIMER_COUNT; ++i) {
+        std::string name = timer_name(static_cast<Timer>(i));
+        ok = put(name + "_ns", snapshot.timer_nanoseconds[i]) && put(name + "_timed", snapshot.timer_calls[i]);
+    }
+    if (!ok) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+    return result;
+}
+
+PyObject* py_metrics_reset(PyObject*, PyObject*) {
+    metrics_reset();
+    Py_RETURN_NONE;
+}
+
+// --- Module ---
+
+PyMethodDef METHODS[] = {
+    {"des_encrypt", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_des_encrypt)),
+     METH_VARARGS | METH_KEYWORDS,
+     "des_encrypt(key, data, mode='CBC', iv=None, threads=0) -> bytes\n"
+     "DES (8-byte key) or 3DES (16 / 24 bytes) in ECB, CBC or CTR, unpadded."},
+    {"des_decrypt", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_des_decrypt)),
+     METH_VARARGS | METH_KEYWORDS,
+     "des_decrypt(key, data, mode='CBC', iv=None, threads=0) -> bytes\nInverse of des_encrypt."},
+    {"des_ctr_offset", py_des_ctr_offset, METH_VARARGS,
+     "des_ctr_offset(key, nonce, data) -> bytes\n"
+     "CTR in CryptoManager's TripleDES fallback layout (last two nonce bytes plus the byte offset)."},
+    {"des_engine", py_des_engine, METH_NOARGS, "des_engine() -> str\nName of the active DES block engine."},
+    {"davies_meyer_des", py_davies_meyer_des, METH_O, "davies_meyer_des(data) -> bytes\n8-byte Davies-Meyer DES digest."},
+    {"merkle_damgard", py_merkle_damgard, METH_O,
+     "merkle_damgard(data) -> bytes\nMerkleDamgardHash(64, 32).hash_bytes(data)."},
+    {"merkle_tree", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_merkle_tree)),
+     METH_VARARGS | METH_KEYWORDS,
+     "merkle_tree(data, threads=0) -> bytes\nParallel Merkle tree root over 64 KiB chunks."},
+    {"xor_bytes", py_xor_bytes, METH_VARARGS, "xor_bytes(a, b) -> bytes\nutils.xor_bytes over buffers."},
+    {"rsa_mod_exp", py_rsa_mod_exp, METH_VARARGS, "rsa_mod_exp(base, exp, mod) -> int\npow(base, exp, mod) up to 4096 bits."},
+    {"rsa_generate_keypair", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_rsa_generate_keypair)),
+     METH_VARARGS | METH_KEYWORDS,
+     "rsa_generate_keypair(bits=2048, threads=0) -> (n, e, d, p, q)"},
+    {"metrics", py_metrics, METH_NOARGS, "metrics() -> dict\nLibrary counters and timer totals over all threads."},
+    {"metrics_reset", py_metrics_reset, METH_NOARGS, "metrics_reset()\nZeroes the library counters and timers."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef MODULE = {
+    PyModuleDef_HEAD_INIT, "_native", "Native DES, hash and RSA cores from libcryptoalgs.", -1, METHODS,
+    nullptr, nullptr, nullptr, nullptr,
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__native() {
+    return PyModule_Create(&MODULE);
+}
@@ -0,0 +1,1632 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "mersenne_twister.hpp"
+#include "metrics.hpp"
+#include "constant_time.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// --- RSA ---
+// BigInt arithmetic, Montgomery and CRT exponentiation, key generation,
+// PKCS#1 v1.5 block encoding and the batch paths. Part of libcryptoalgs:
+// the templates are defined here, the standard key sizes are instantiated
+// once in src/rsa.cpp (see the end of this file), and the few non-template
+// helpers live there too.
+
+// --- Scratch Arena ---
+// Fixed-capacity bump allocator for the temporary limbs that BigInt
+// arithmetic needs (double-width products, normalized division operands).
+// Allocations are released LIFO through ArenaScope, so an operation's
+// temporaries vanish in one step and steady-state arithmetic never touches
+// the heap. Each thread gets its own arena.
+
+class LimbArena {
+public:
+    explicit LimbArena(size_t capacity_limbs)
+        : storage_(new uint64_t[capacity_limbs]), capacity_(capacity_limbs), top_(0) {}
+
+    uint64_t* allocate(size_t count) {
+        if (count > capacity_ - top_) throw std::bad_alloc();
+        uint64_t* block = storage_.get() + top_;
+        top_ += count;
+        return block;
+    }
+
+    size_t mark() const { return top_; }
+    void release(size_t mark) { top_ = mark; }
+
+private:
+    std::unique_ptr<uint64_t[]> storage_;
+    size_t capacity_;
+    size_t top_;
+};
+
+// Releases everything allocated from the arena since construction
+struct ArenaScope {
+    LimbArena& arena;
+    size_t mark;
+
+    explicit ArenaScope(LimbArena& a) : arena(a), mark(a.mark()) {}
+    ~ArenaScope() { arena.release(mark); }
+};
+
+// 16K limbs (128 KiB) covers the deepest scratch use of 8192-bit operands
+inline LimbArena& thread_arena() {
+    thread_local LimbArena arena(16 * 1024);
+    return arena;
+}
+
+// --- Limb Arithmetic ---
+// Little-endian arrays of 64-bit limbs; the BigInt operators below are thin
+// wrappers over these.
+
+typedef unsigned __int128 uint128_t;
+
+// Number of limbs up to and including the highest non-zero one
+inline size_t significant_limbs(const uint64_t* a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) --n;
+    return n;
+}
+
+inline int compare_limbs(const uint64_t* a, const uint64_t* b, size_t n) {
+    for (size_t i = n; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r = a + b over n limbs, returns the carry out
+inline uint64_t add_limbs(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint128_t sum = static_cast<uint128_t>(a[i]) + b[i] + carry;
+        r[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    return carry;
+}
+
+// r = a - b over n limbs, returns the borrow out
+inline uint64_t sub_limbs(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t diff = a[i] - b[i];
+        uint64_t next_borrow = (a[i] < b[i]) | (diff < borrow);
+        r[i] = diff - borrow;
+        borrow = next_borrow;
+    }
+    return borrow;
+}
+
+// Masked variants for constant-time code: every limb is touched and no
+// branch depends on the values; mask is all ones or all zeros
+inline uint64_t add_limbs_masked(uint64_t* r, const uint64_t* b, uint64_t mask, size_t n) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint128_t sum = static_cast<uint128_t>(r[i]) + (b[i] & mask) + carry;
+        r[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    return carry;
+}
+
+inline uint64_t sub_limbs_masked(uint64_t* r, const uint64_t* b, uint64_t mask, size_t n) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint128_t diff = static_cast<uint128_t>(r[i]) - (b[i] & mask) - borrow;
+        r[i] = static_cast<uint64_t>(diff);
+        borrow = static_cast<uint64_t>(diff >> 64) & 1;
+    }
+    return borrow;
+}
+
+inline void swap_limbs_masked(uint64_t* a, uint64_t* b, uint64_t mask, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t diff = (a[i] ^ b[i]) & mask;
+        a[i] ^= diff;
+        b[i] ^= diff;
+    }
+}
+
+// r = a * b, r has na + nb limbs and must not overlap a or b
+inline void mul_limbs(uint64_t* r, const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+    for (size_t i = 0; i < na + nb; ++i) r[i] = 0;
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < nb; ++j) {
+            uint128_t product = static_cast<uint128_t>(a[i]) * b[j] + r[i + j] + carry;
+            r[i + j] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        r[i + nb] = carry;
+    }
+}
+
+// Long division (Knuth, TAOCP vol. 2, 4.3.1 Algorithm D). u has m limbs and
+// v has n limbs with a non-zero top limb after trimming. Writes m - n + 1
+// quotient limbs to q (if not null) and n remainder limbs to r (if not null).
+void divmod_limbs(const uint64_t* u, size_t m, const uint64_t* v, size_t n,
+                  uint64_t* q, uint64_t* r, LimbArena& arena);
+
+// --- Fixed-Width BigInt ---
+// Unsigned integer of exactly Bits bits held inline, so values live on the
+// stack or inside other objects and never allocate. Arithmetic wraps modulo
+// 2^Bits except where noted; modular helpers work through the thread arena.
+
+template <size_t Bits>
+struct BigInt {
+    static_assert(Bits > 0 && Bits % 64 == 0, "BigInt width must be a multiple of 64 bits");
+    static constexpr size_t LIMBS = Bits / 64;
+
+    uint64_t limbs[LIMBS];
+
+    BigInt() : limbs{} {}
+    BigInt(uint64_t value) : limbs{} { limbs[0] = value; }
+
+    // Parses decimal digits, or hex with a 0x prefix
+    static BigInt from_string(const std::string& text) {
+        BigInt value;
+        bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+        for (size_t i = hex ? 2 : 0; i < text.size(); ++i) {
+            char c = text[i];
+            uint64_t digit;
+            if (c >= '0' && c <= '9') digit = c - '0';
+            else if (hex && c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (hex && c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            else throw std::invalid_argument("invalid digit in BigInt literal");
+            if (value.mul_add_small(hex ? 16 : 10, digit) != 0) {
+                throw std::overflow_error("BigInt literal does not fit");
+            }
+        }
+        return value;
+    }
+
+    std::string to_string() const {
+        // Peel off 19 decimal digits at a time
+        const uint64_t chunk = 10000000000000000000ull;
+        BigInt value = *this;
+        std::string digits;
+        do {
+            uint64_t part = value.divmod_small(chunk);
+            bool last = value.is_zero();
+            for (int i = 0; i < 19 && (!last || part != 0); ++i) {
+                digits.push_back(static_cast<char>('0' + part % 10));
+                part /= 10;
+            }
+        } while (!value.is_zero());
+        if (digits.empty()) digits = "0";
+        return std::string(digits.rbegin(), digits.rend());
+    }
+
+    // Big-endian bytes; leading bytes beyond the width must be zero
+    static BigInt from_bytes(const uint8_t* bytes, size_t length) {
+        BigInt value;
+        for (size_t i = 0; i < length; ++i) {
+            size_t position = length - 1 - i;
+            if (position / 8 >= LIMBS) {
+                if (bytes[i] != 0) throw std::overflow_error("BigInt bytes do not fit");
+                continue;
+            }
+            value.limbs[position / 8] |= static_cast<uint64_t>(bytes[i]) << (8 * (position % 8));
+        }
+        return value;
+    }
+
+    // Writes the low length bytes big-endian (left-padded with zeros)
+    void to_bytes(uint8_t* bytes, size_t length) const {
+        for (size_t i = 0; i < length; ++i) {
+            size_t position = length - 1 - i;
+            bytes[i] = position / 8 < LIMBS ? static_cast<uint8_t>(limbs[position / 8] >> (8 * (position % 8))) : 0;
+        }
+    }
+
+    bool is_zero() const { return significant_limbs(limbs, LIMBS) == 0; }
+    bool is_odd() const { return limbs[0] & 1; }
+    bool bit(size_t i) const { return (limbs[i / 64] >> (i % 64)) & 1; }
+
+    size_t bit_length() const {
+        size_t n = significant_limbs(limbs, LIMBS);
+        return n == 0 ? 0 : 64 * n - __builtin_clzll(limbs[n - 1]);
+    }
+
+    // Number of low zero bits; 0 for zero
+    size_t trailing_zeros() const {
+        for (size_t i = 0; i < LIMBS; ++i) {
+            if (limbs[i] != 0) return 64 * i + __builtin_ctzll(limbs[i]);
+        }
+        return 0;
+    }
+
+    // this = this * factor + addend, returns the limb carried out of the top
+    uint64_t mul_add_small(uint64_t factor, uint64_t addend) {
+        uint64_t carry = addend;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            uint128_t product = static_cast<uint128_t>(limbs[i]) * factor + carry;
+            limbs[i] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        return carry;
+    }
+
+    // this = this / divisor, returns the remainder
+    uint64_t divmod_small(uint64_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = LIMBS; i-- > 0;) {
+            uint128_t numerator = (static_cast<uint128_t>(remainder) << 64) | limbs[i];
+            limbs[i] = static_cast<uint64_t>(numerator / divisor);
+            remainder = static_cast<uint64_t>(numerator % divisor);
+        }
+        return remainder;
+    }
+
+    // this % divisor without modifying this
+    uint64_t mod_small(uint64_t divisor) const {
+        uint64_t remainder = 0;
+        for (size_t i = LIMBS; i-- > 0;) {
+            uint128_t numerator = (static_cast<uint128_t>(remainder) << 64) | limbs[i];
+            remainder = static_cast<uint64_t>(numerator % divisor);
+        }
+        return remainder;
+    }
+
+    BigInt& operator+=(const BigInt& other) { add_limbs(limbs, limbs, other.limbs, LIMBS); return *this; }
+    BigInt& operator-=(const BigInt& other) { sub_limbs(limbs, limbs, other.limbs, LIMBS); return *this; }
+
+    BigInt& operator<<=(size_t shift) {
+        size_t limb_shift = shift / 64, bit_shift = shift % 64;
+        for (size_t i = LIMBS; i-- > 0;) {
+            uint64_t high = i >= limb_shift ? limbs[i - limb_shift] : 0;
+            uint64_t low = i >= limb_shift + 1 ? limbs[i - limb_shift - 1] : 0;
+            limbs[i] = bit_shift ? (high << bit_shift) | (low >> (64 - bit_shift)) : high;
+        }
+        return *this;
+    }
+
+    BigInt& operator>>=(size_t shift) {
+        size_t limb_shift = shift / 64, bit_shift = shift % 64;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            uint64_t low = i + limb_shift < LIMBS ? limbs[i + limb_shift] : 0;
+            uint64_t high = i + limb_shift + 1 < LIMBS ? limbs[i + limb_shift + 1] : 0;
+            limbs[i] = bit_shift ? (low >> bit_shift) | (high << (64 - bit_shift)) : low;
+        }
+        return *this;
+    }
+
+    friend BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+    friend BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+    friend BigInt operator<<(BigInt a, size_t shift) { return a <<= shift; }
+    friend BigInt operator>>(BigInt a, size_t shift) { return a >>= shift; }
+
+    // Truncated product (low Bits bits)
+    friend BigInt operator*(const BigInt& a, const BigInt& b) {
+        LimbArena& arena = thread_arena();
+        ArenaScope scope(arena);
+        size_t na = significant_limbs(a.limbs, LIMBS), nb = significant_limbs(b.limbs, LIMBS);
+        BigInt result;
+        if (na == 0 || nb == 0) return result;
+        uint64_t* product = arena.allocate(na + nb);
+        mul_limbs(product, a.limbs, na, b.limbs, nb);
+        for (size_t i = 0; i < LIMBS && i < na + nb; ++i) result.limbs[i] = product[i];
+        return result;
+    }
+
+    friend BigInt operator/(const BigInt& a, const BigInt& b) {
+        BigInt quotient;
+        divmod_limbs(a.limbs, LIMBS, b.limbs, LIMBS, quotient.limbs, nullptr, thread_arena());
+        return quotient;
+    }
+
+    friend BigInt operator%(const BigInt& a, const BigInt& b) {
+        BigInt remainder;
+        divmod_limbs(a.limbs, LIMBS, b.limbs, LIMBS, nullptr, remainder.limbs, thread_arena());
+        return remainder;
+    }
+
+    friend bool operator==(const BigInt& a, const BigInt& b) { return compare_limbs(a.limbs, b.limbs, LIMBS) == 0; }
+    friend bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
+    friend bool operator<(const BigInt& a, const BigInt& b) { return compare_limbs(a.limbs, b.limbs, LIMBS) < 0; }
+    friend bool operator>(const BigInt& a, const BigInt& b) { return b < a; }
+    friend bool operator<=(const BigInt& a, const BigInt& b) { return !(b < a); }
+    friend bool operator>=(const BigInt& a, const BigInt& b) { return !(a < b); }
+
+    friend std::ostream& operator<<(std::ostream& out, const BigInt& value) { return out << value.to_string(); }
+};
+
+// Converts between widths, truncating to the low To bits when narrowing
+template <size_t To, size_t From>
+BigInt<To> bigint_cast(const BigInt<From>& value) {
+    BigInt<To> result;
+    for (size_t i = 0; i < BigInt<To>::LIMBS && i < BigInt<From>::LIMBS; ++i) {
+        result.limbs[i] = value.limbs[i];
+    }
+    return result;
+}
+
+// a % mod for a modulus of a narrower type, e.g. a ciphertext reduced by one prime
+template <size_t To, size_t From>
+BigInt<To> reduce(const BigInt<From>& a, const BigInt<To>& mod) {
+    BigInt<To> remainder;
+    divmod_limbs(a.limbs, BigInt<From>::LIMBS, mod.limbs, BigInt<To>::LIMBS, nullptr, remainder.limbs, thread_arena());
+    return remainder;
+}
+
+// (a * b) % mod without overflow: the full double-width product is reduced
+template <size_t Bits>
+BigInt<Bits> mul_mod(const BigInt<Bits>& a, const BigInt<Bits>& b, const BigInt<Bits>& mod) {
+    constexpr size_t L = BigInt<Bits>::LIMBS;
+    LimbArena& arena = thread_arena();
+    ArenaScope scope(arena);
+    uint64_t* product = arena.allocate(2 * L);
+    mul_limbs(product, a.limbs, L, b.limbs, L);
+    BigInt<Bits> result;
+    divmod_limbs(product, 2 * L, mod.limbs, L, nullptr, result.limbs, arena);
+    return result;
+}
+
+// Greatest Common Divisor (binary / Stein): shifts and subtractions only.
+// When the operands differ by more than a limb in size, one division first
+// brings the larger down, since subtraction would only strip a bit or so
+// per step (e.g. gcd(e, phi) with a small e).
+template <size_t Bits>
+BigInt<Bits> gcd(BigInt<Bits> a, BigInt<Bits> b) {
+    if (a < b) std::swap(a, b);
+    if (significant_limbs(a.limbs, BigInt<Bits>::LIMBS) > significant_limbs(b.limbs, BigInt<Bits>::LIMBS) + 1 &&
+        !b.is_zero()) {
+        a = a % b;
+    }
+    if (a.is_zero()) return b;
+    if (b.is_zero()) return a;
+
+    size_t shift = std::min(a.trailing_zeros(), b.trailing_zeros());
+    a >>= a.trailing_zeros();
+    do {
+        // a is odd; strip b's factors of two, then subtract the smaller
+        b >>= b.trailing_zeros();
+        if (a > b) std::swap(a, b);
+        b -= a;
+    } while (!b.is_zero());
+    return a << shift;
+}
+
+// --- Montgomery Arithmetic ---
+// For an odd modulus n of k limbs, with R = 2^(64k), values are kept as
+// aR mod n and multiplied with REDC, which reduces by shifting limbs out
+// instead of dividing. Everything that depends only on n (k, R mod n,
+// R^2 mod n and n' = -n^-1 mod 2^64) is computed once here, so a context
+// built per modulus (or per key) makes every later exponentiation
+// division-free apart from converting the base in.
+
+template <size_t Bits>
+struct MontgomeryContext {
+    BigInt<Bits> modulus;
+    BigInt<Bits> one;       // R mod n, i.e. 1 in Montgomery form
+    BigInt<Bits> r_squared; // R^2 mod n, converts into Montgomery form
+    uint64_t n_prime;       // -n^-1 mod 2^64
+    size_t limb_count;      // k, significant limbs of n
+
+    explicit MontgomeryContext(const BigInt<Bits>& n) : modulus(n) {
+        if (!n.is_odd() || n == BigInt<Bits>(1)) {
+            throw std::invalid_argument("Montgomery modulus must be odd and greater than 1");
+        }
+        limb_count = significant_limbs(n.limbs, BigInt<Bits>::LIMBS);
+
+        // Newton iteration for n[0]^-1 mod 2^64: each step doubles the correct low bits
+        uint64_t inverse = n.limbs[0];
+        for (int i = 0; i < 6; ++i) {
+            inverse *= 2 - n.limbs[0] * inverse;
+        }
+        n_prime = 0 - inverse;
+
+        // R^2 mod n straight from 2^(128k) with one long division; R mod n via REDC(R^2)
+        LimbArena& arena = thread_arena();
+        ArenaScope scope(arena);
+        uint64_t* r2_numerator = arena.allocate(2 * limb_count + 1);
+        for (size_t i = 0; i < 2 * limb_count; ++i) r2_numerator[i] = 0;
+        r2_numerator[2 * limb_count] = 1;
+        divmod_limbs(r2_numerator, 2 * limb_count + 1, n.limbs, limb_count, nullptr, r_squared.limbs, arena);
+        one = multiply(r_squared, BigInt<Bits>(1));
+    }
+
+    // REDC(a * b) = a * b * R^-1 mod n for a, b < n (CIOS: interleaved multiply and reduce)
+    BigInt<Bits> multiply(const BigInt<Bits>& a, const BigInt<Bits>& b) const {
+        const size_t k = limb_count;
+        const uint64_t* n = modulus.limbs;
+        uint64_t t[BigInt<Bits>::LIMBS + 2] = {};
+        for (size_t i = 0; i < k; ++i) {
+            // t += a * b[i]
+            uint64_t carry = 0;
+            for (size_t j = 0; j < k; ++j) {
+                uint128_t sum = static_cast<uint128_t>(a.limbs[j]) * b.limbs[i] + t[j] + carry;
+                t[j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            uint128_t top = static_cast<uint128_t>(t[k]) + carry;
+            t[k] = static_cast<uint64_t>(top);
+            t[k + 1] = static_cast<uint64_t>(top >> 64);
+
+            // t = (t + m * n) / 2^64, with m chosen so the low limb cancels
+            uint64_t m = t[0] * n_prime;
+            uint128_t sum = static_cast<uint128_t>(m) * n[0] + t[0];
+            carry = static_cast<uint64_t>(sum >> 64);
+            for (size_t j = 1; j < k; ++j) {
+                sum = static_cast<uint128_t>(m) * n[j] + t[j] + carry;
+                t[j - 1] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            top = static_cast<uint128_t>(t[k]) + carry;
+            t[k - 1] = static_cast<uint64_t>(top);
+            t[k] = t[k + 1] + static_cast<uint64_t>(top >> 64);
+        }
+
+        // t < 2n, one conditional subtraction brings it below n
+        return subtract_once(t, t[k]);
+    }
+
+    BigInt<Bits> to_montgomery(const BigInt<Bits>& a) const { return multiply(a % modulus, r_squared); }
+    BigInt<Bits> from_montgomery(const BigInt<Bits>& a) const { return multiply(a, BigInt<Bits>(1)); }
+
+    // a * R mod n for a of any width, without dividing by n: the k-limb
+    // chunks of a are folded in from the top (Horner), and each step moves
+    // the running value and the next chunk up by R through a REDC with R^2.
+    // REDC(x, R^2) stays exact for any x < R, so chunks need no reduction.
+    template <size_t From>
+    BigInt<Bits> to_montgomery_ct(const BigInt<From>& a) const {
+        constexpr size_t L = BigInt<From>::LIMBS;
+        const size_t k = limb_count;
+        BigInt<Bits> value;
+        for (size_t top = (L + k - 1) / k * k; top > 0; top -= k) {
+            BigInt<Bits> chunk;
+            for (size_t j = 0; j < k && top - k + j < L; ++j) chunk.limbs[j] = a.limbs[top - k + j];
+            BigInt<Bits> shifted = multiply(value, r_squared);
+            BigInt<Bits> part = multiply(chunk, r_squared);
+            uint64_t sum[BigInt<Bits>::LIMBS];
+            uint64_t carry = add_limbs(sum, shifted.limbs, part.limbs, k);
+            value = subtract_once(sum, carry);
+        }
+        return value;
+    }
+
+private:
+    // t (k limbs plus an overflow bit) minus n if t >= n, for t < 2n. The
+    // constant-time build always subtracts and selects through a mask.
+    BigInt<Bits> subtract_once(const uint64_t* t, uint64_t overflow) const {
+        const size_t k = limb_count;
+        BigInt<Bits> result;
+#if CRYPTOALGS_CONSTANT_TIME
+        uint64_t borrow = sub_limbs(result.limbs, t, modulus.limbs, k);
+        uint64_t keep_t = ct_bit_mask(borrow & ~overflow);
+        for (size_t j = 0; j < k; ++j) result.limbs[j] = ct_select(keep_t, t[j], result.limbs[j]);
+#else
+        if (overflow != 0 || compare_limbs(t, modulus.limbs, k) >= 0) {
+            sub_limbs(result.limbs, t, modulus.limbs, k);
+        } else {
+            for (size_t j = 0; j < k; ++j) result.limbs[j] = t[j];
+        }
+#endif
+        return result;
+    }
+};
+
+// --- Windowed Exponentiation ---
+
+// Window width used when the caller passes 0: wider windows cost a bigger
+// odd-powers table (2^(w-1) entries) but save multiplies on long exponents
+inline size_t default_window_bits(size_t exp_bits) {
+    if (exp_bits > 1536) return 6;
+    if (exp_bits > 512) return 5;
+    if (exp_bits > 128) return 4;
+    if (exp_bits > 24) return 3;
+    return 1;
+}
+
+inline constexpr size_t MAX_WINDOW_BITS = 6;
+
+// Modular Exponentiation (base^exp % mod) with a cached Montgomery context,
+// for public exponents. Left-to-right sliding window over the exponent:
+// every run of up to window_bits bits that starts and ends with a 1 costs
+// one multiply by a precomputed odd power x^1, x^3, ..., x^(2^w - 1).
+// window_bits == 0 picks a width from the exponent length; widths are
+// clamped to 1..6. The operation sequence follows the exponent's bits.
+template <size_t Bits>
+BigInt<Bits> mod_exp_vartime(const BigInt<Bits>& base, const BigInt<Bits>& exp, const MontgomeryContext<Bits>& ctx,
+                             size_t window_bits = 0) {
+    CRYPTOALGS_COUNT(ModExpCalls, 1);
+    CRYPTOALGS_TIME_SCOPE(ModExp);
+    size_t bits = exp.bit_length();
+    if (bits == 0) return BigInt<Bits>(1) % ctx.modulus;
+    if (window_bits == 0) window_bits = default_window_bits(bits);
+    window_bits = std::min(std::max<size_t>(window_bits, 1), MAX_WINDOW_BITS);
+    size_t squarings = 0, multiplies = 0;
+
+    // Odd powers table: odd_powers[i] = x^(2i+1) in Montgomery form
+    BigInt<Bits> odd_powers[1 << (MAX_WINDOW_BITS - 1)];
+    odd_powers[0] = ctx.to_montgomery(base);
+    size_t table_size = size_t(1) << (window_bits - 1);
+    if (table_size > 1) {
+        BigInt<Bits> x_squared = ctx.multiply(odd_powers[0], odd_powers[0]);
+        for (size_t i = 1; i < table_size; ++i) {
+            odd_powers[i] = ctx.multiply(odd_powers[i - 1], x_squared);
+        }
+        squarings += 1;
+        multiplies += table_size - 1;
+    }
+
+    BigInt<Bits> result = ctx.one;
+    bool started = false; // skip squaring the leading 1
+    for (size_t i = bits; i-- > 0;) {
+        if (!exp.bit(i)) {
+            if (started) {
+                result = ctx.multiply(result, result);
+                ++squarings;
+            }
+            continue;
+        }
+        // Longest window [low, i] no wider than window_bits that ends in a 1
+        size_t low = i + 1 >= window_bits ? i + 1 - window_bits : 0;
+        while (!exp.bit(low)) ++low;
+        size_t value = 0;
+        for (size_t j = i + 1; j-- > low;) {
+            value = (value << 1) | exp.bit(j);
+            if (started) {
+                result = ctx.multiply(result, result);
+                ++squarings;
+            }
+        }
+        if (started) ++multiplies;
+        result = started ? ctx.multiply(result, odd_powers[value >> 1]) : odd_powers[value >> 1];
+        started = true;
+        i = low;
+    }
+    CRYPTOALGS_COUNT(ModExpSquarings, squarings);
+    CRYPTOALGS_COUNT(ModExpMultiplies, multiplies);
+    return ctx.from_montgomery(result);
+}
+
+// Montgomery ladder over all Bits bits of exp, for x already in Montgomery
+// form; returns x^exp in Montgomery form. Every bit costs one multiply and
+// one squaring, and the two running values trade places through masked
+// swaps, so neither the operations nor the memory touched depend on exp.
+template <size_t Bits>
+BigInt<Bits> montgomery_ladder(const BigInt<Bits>& x, const BigInt<Bits>& exp, const MontgomeryContext<Bits>& ctx) {
+    constexpr size_t N = BigInt<Bits>::LIMBS;
+    BigInt<Bits> r0 = ctx.one, r1 = x; // invariant r1 = r0 * x
+    for (size_t i = Bits; i-- > 0;) {
+        uint64_t swap = ct_bit_mask(exp.limbs[i / 64] >> (i % 64));
+        swap_limbs_masked(r0.limbs, r1.limbs, swap, N);
+        r1 = ctx.multiply(r0, r1);
+        r0 = ctx.multiply(r0, r0);
+        swap_limbs_masked(r0.limbs, r1.limbs, swap, N);
+    }
+    CRYPTOALGS_COUNT(ModExpSquarings, Bits);
+    CRYPTOALGS_COUNT(ModExpMultiplies, Bits);
+    return r0;
+}
+
+// Modular Exponentiation for secret exponents, in constant time (the base
+// is converted in without a division, so it may be any value below 2^Bits)
+template <size_t Bits>
+BigInt<Bits> mod_exp_ladder(const BigInt<Bits>& base, const BigInt<Bits>& exp, const MontgomeryContext<Bits>& ctx) {
+    CRYPTOALGS_COUNT(ModExpCalls, 1);
+    CRYPTOALGS_TIME_SCOPE(ModExp);
+    return ctx.from_montgomery(montgomery_ladder(ctx.to_montgomery_ct(base), exp, ctx));
+}
+
+// Modular Exponentiation (base^exp % mod) with a cached Montgomery context:
+// the sliding window, or the ladder in the constant-time build
+template <size_t Bits>
+BigInt<Bits> mod_exp(const BigInt<Bits>& base, const BigInt<Bits>& exp, const MontgomeryContext<Bits>& ctx,
+                     size_t window_bits = 0) {
+#if CRYPTOALGS_CONSTANT_TIME
+    (void)window_bits;
+    return mod_exp_ladder(base, exp, ctx);
+#else
+    return mod_exp_vartime(base, exp, ctx, window_bits);
+#endif
+}
+
+// --- Batch Exponentiation ---
+// Many bases raised to the same exponent under one modulus (RSA public key
+// operations: encryption, or verifying signatures under a shared e). The
+// sliding-window schedule depends only on the exponent, so every base takes
+// the same path and the per-modulus setup is shared by the whole batch.
+//
+// 64x64 -> 128-bit limb products have no AVX2/AVX-512F vector form, so the
+// multi-lane path uses AVX-512 IFMA (52x52 -> 104-bit multiply-add): each
+// base is held in radix 2^52 and eight bases ride in one register per digit.
+// Without IFMA the batch falls back to mod_exp per base on the shared context.
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define RSA_HAVE_IFMA 1
+#else
+#define RSA_HAVE_IFMA 0
+#endif
+
+#if RSA_HAVE_IFMA
+inline constexpr size_t IFMA_LANES = 8;
+inline constexpr uint64_t DIGIT_MASK = (uint64_t(1) << 52) - 1;
+
+// Montgomery constants for R = 2^(52k), k = number of 52-bit digits of n
+template <size_t Bits>
+struct Radix52Context {
+    static constexpr size_t MAX_DIGITS = (Bits + 51) / 52;
+    size_t digits;
+    uint64_t n_prime; // -n^-1 mod 2^52
+    uint64_t modulus[MAX_DIGITS + 1];
+    uint64_t r_squared[MAX_DIGITS + 1]; // R^2 mod n
+
+    explicit Radix52Context(const MontgomeryContext<Bits>& ctx) : n_prime(ctx.n_prime & DIGIT_MASK) {
+        digits = (ctx.modulus.bit_length() + 51) / 52;
+        to_digits(ctx.modulus, modulus);
+
+        // R^2 mod n from 2^(104k) with one long division
+        size_t k = ctx.limb_count;
+        size_t numerator_limbs = (104 * digits) / 64 + 1;
+        LimbArena& arena = thread_arena();
+        ArenaScope scope(arena);
+        uint64_t* numerator = arena.allocate(numerator_limbs);
+        for (size_t i = 0; i < numerator_limbs; ++i) numerator[i] = 0;
+        numerator[(104 * digits) / 64] = uint64_t(1) << ((104 * digits) % 64);
+        BigInt<Bits> remainder;
+        divmod_limbs(numerator, numerator_limbs, ctx.modulus.limbs, k, nullptr, remainder.limbs, arena);
+        to_digits(remainder, r_squared);
+    }
+
+    // Splits a < 2^(52k) into k + 1 digits (the top one zero)
+    void to_digits(const BigInt<Bits>& a, uint64_t* out) const {
+        for (size_t j = 0; j <= digits; ++j) {
+            size_t bit = 52 * j;
+            size_t limb = bit / 64, shift = bit % 64;
+            uint64_t value = limb < BigInt<Bits>::LIMBS ? a.limbs[limb] >> shift : 0;
+            if (shift > 12 && limb + 1 < BigInt<Bits>::LIMBS) value |= a.limbs[limb + 1] << (64 - shift);
+            out[j] = value & DIGIT_MASK;
+        }
+    }
+
+    BigInt<Bits> from_digits(const uint64_t* in, size_t stride) const {
+        BigInt<Bits> a;
+        for (size_t j = 0; j < digits; ++j) {
+            uint64_t digit = in[j * stride];
+            size_t bit = 52 * j;
+            size_t limb = bit / 64, shift = bit % 64;
+            a.limbs[limb] |= digit << shift;
+            if (shift > 12 && limb + 1 < BigInt<Bits>::LIMBS) a.limbs[limb + 1] |= digit >> (64 - shift);
+        }
+        return a;
+    }
+};
+
+// Eight-lane REDC(a * b) with values digit-major: x[j * 8 + l] is digit j of
+// lane l. Inputs are below n with 52-bit digits; so is the result. The
+// accumulators are 64 bits wide, so carries are only resolved at the end
+// (4k partial products of < 2^52 each stay below 2^64 for k < 1000).
+// Zero-masked shift: GCC 12 warns on the unmasked intrinsic's undefined passthrough
+__attribute__((target("avx512f"), always_inline))
+inline __m512i shift_right(__m512i x, unsigned int bits) {
+    return _mm512_maskz_srli_epi64(0xFF, x, bits);
+}
+
+template <size_t Bits>
+__attribute__((target("avx512f,avx512ifma")))
+void ifma_multiply(uint64_t* r, const uint64_t* a, const uint64_t* b, const Radix52Context<Bits>& ctx) {
+    constexpr size_t MAX = Radix52Context<Bits>::MAX_DIGITS;
+    const size_t k = ctx.digits;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask = _mm512_set1_epi64(DIGIT_MASK);
+    const __m512i n_prime = _mm512_set1_epi64(ctx.n_prime);
+
+    // Iteration i works on the window t[i .. i + k]; t[i] is divisible by
+    // 2^52 once m * n is added, so its carry moves up instead of shifting
+    __m512i t[2 * MAX + 1];
+    for (size_t j = 0; j <= 2 * k; ++j) t[j] = zero;
+    for (size_t i = 0; i < k; ++i) {
+        __m512i* w = t + i;
+        const __m512i bi = _mm512_loadu_si512(b + i * IFMA_LANES);
+        for (size_t j = 0; j < k; ++j) {
+            const __m512i aj = _mm512_loadu_si512(a + j * IFMA_LANES);
+            w[j] = _mm512_madd52lo_epu64(w[j], aj, bi);
+            w[j + 1] = _mm512_madd52hi_epu64(w[j + 1], aj, bi);
+        }
+        const __m512i m = _mm512_madd52lo_epu64(zero, w[0], n_prime);
+        for (size_t j = 0; j < k; ++j) {
+            const __m512i nj = _mm512_set1_epi64(ctx.modulus[j]);
+            w[j] = _mm512_madd52lo_epu64(w[j], m, nj);
+            w[j + 1] = _mm512_madd52hi_epu64(w[j + 1], m, nj);
+        }
+        w[1] = _mm512_add_epi64(w[1], shift_right(w[0], 52));
+    }
+
+    // Normalize t[k .. 2k] to 52-bit digits, then subtract n once if t >= n
+    __m512i* result = t + k;
+    __m512i carry = zero;
+    for (size_t j = 0; j <= k; ++j) {
+        result[j] = _mm512_add_epi64(result[j], carry);
+        carry = shift_right(result[j], 52);
+        result[j] = _mm512_and_si512(result[j], mask);
+    }
+    __m512i reduced[MAX + 1];
+    __m512i borrow = zero;
+    for (size_t j = 0; j <= k; ++j) {
+        __m512i diff = _mm512_sub_epi64(_mm512_sub_epi64(result[j], _mm512_set1_epi64(ctx.modulus[j])), borrow);
+        borrow = shift_right(diff, 63);
+        reduced[j] = _mm512_and_si512(diff, mask);
+    }
+    __mmask8 keep = _mm512_cmpneq_epi64_mask(borrow, zero); // t < n
+    for (size_t j = 0; j < k; ++j) {
+        _mm512_storeu_si512(r + j * IFMA_LANES, _mm512_mask_blend_epi64(keep, reduced[j], result[j]));
+    }
+}
+
+// Whether the CPU has AVX-512F and AVX-512 IFMA
+bool cpu_has_ifma();
+
+// Eight bases at a time through the same sliding window as mod_exp. A short
+// final group is padded with copies of its last base.
+template <size_t Bits>
+void mod_exp_batch_ifma(const BigInt<Bits>* bases, BigInt<Bits>* out, size_t count, const BigInt<Bits>& exp,
+                        const MontgomeryContext<Bits>& ctx, size_t window_bits) {
+    constexpr size_t L = IFMA_LANES;
+    Radix52Context<Bits> radix(ctx);
+    const size_t k = radix.digits;
+    const size_t words = k * L;
+    size_t bits = exp.bit_length();
+    size_t table_size = size_t(1) << (window_bits - 1);
+    CRYPTOALGS_TIME_SCOPE(ModExp);
+    size_t squarings = 0, multiplies = 0; // per lane, over the whole batch
+
+    // Constant operands broadcast to every lane
+    std::vector<uint64_t> r_squared(words), unit(words, 0);
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t l = 0; l < L; ++l) r_squared[j * L + l] = radix.r_squared[j];
+    }
+    for (size_t l = 0; l < L; ++l) unit[l] = 1;
+
+    // odd_powers[i] = x^(2i+1) in Montgomery form, all lanes
+    std::vector<uint64_t> odd_powers(table_size * words), x_squared(words), result(words);
+    uint64_t digits[Radix52Context<Bits>::MAX_DIGITS + 1];
+    for (size_t first = 0; first < count; first += L) {
+        size_t lanes = std::min(L, count - first);
+        for (size_t l = 0; l < L; ++l) {
+            radix.to_digits(bases[first + std::min(l, lanes - 1)] % ctx.modulus, digits);
+            for (size_t j = 0; j < k; ++j) result[j * L + l] = digits[j];
+        }
+        ifma_multiply(odd_powers.data(), result.data(), r_squared.data(), radix);
+        if (table_size > 1) {
+            ifma_multiply(x_squared.data(), odd_powers.data(), odd_powers.data(), radix);
+            for (size_t i = 1; i < table_size; ++i) {
+                ifma_multiply(&odd_powers[i * words], &odd_powers[(i - 1) * words], x_squared.data(), radix);
+            }
+            squarings += lanes;
+            multiplies += (table_size - 1) * lanes;
+        }
+
+        bool started = false;
+        for (size_t i = bits; i-- > 0;) {
+            if (!exp.bit(i)) {
+                if (started) {
+                    ifma_multiply(result.data(), result.data(), result.data(), radix);
+                    squarings += lanes;
+                }
+                continue;
+            }
+            size_t low = i + 1 >= window_bits ? i + 1 - window_bits : 0;
+            while (!exp.bit(low)) ++low;
+            size_t value = 0;
+            for (size_t j = i + 1; j-- > low;) {
+                value = (value << 1) | exp.bit(j);
+                if (started) {
+                    ifma_multiply(result.data(), result.data(), result.data(), radix);
+                    squarings += lanes;
+                }
+            }
+            const uint64_t* power = &odd_powers[(value >> 1) * words];
+            if (started) {
+                ifma_multiply(result.data(), result.data(), power, radix);
+                multiplies += lanes;
+            } else {
+                std::copy(power, power + words, result.begin());
+            }
+            started = true;
+            i = low;
+        }
+
+        ifma_multiply(result.data(), result.data(), unit.data(), radix);
+        for (size_t l = 0; l < lanes; ++l) out[first + l] = radix.from_digits(&result[l], L);
+    }
+    CRYPTOALGS_COUNT(ModExpCalls, count);
+    CRYPTOALGS_COUNT(ModExpSquarings, squarings);
+    CRYPTOALGS_COUNT(ModExpMultiplies, multiplies);
+}
+#endif
+
+// out[i] = bases[i]^exp mod n for i < count; out may alias bases
+template <size_t Bits>
+void mod_exp_batch(const BigInt<Bits>* bases, BigInt<Bits>* out, size_t count, const BigInt<Bits>& exp,
+                   const MontgomeryContext<Bits>& ctx, size_t window_bits = 0) {
+    size_t bits = exp.bit_length();
+    if (window_bits == 0) window_bits = default_window_bits(bits);
+    window_bits = std::min(std::max<size_t>(window_bits, 1), MAX_WINDOW_BITS);
+#if RSA_HAVE_IFMA
+    if (bits > 0 && count > 1 && cpu_has_ifma()) {
+        mod_exp_batch_ifma(bases, out, count, exp, ctx, window_bits);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) out[i] = mod_exp_vartime(bases[i], exp, ctx, window_bits);
+}
+
+// --- Fixed-Base Comb Exponentiation ---
+// For a base that is raised to many different exponents (Lim-Lee comb).
+// The exponent's bits are laid out as a teeth x spacing grid. Column k picks
+// one bit from each row at positions k, k + spacing, k + 2*spacing, ... and
+// together they index a table of products of base^(2^(row*spacing)). One
+// pass then costs spacing squarings plus at most spacing multiplies,
+// whatever the exponent is.
+
+template <size_t Bits>
+class FixedBaseExp {
+public:
+    FixedBaseExp(const BigInt<Bits>& base, size_t max_exp_bits, const MontgomeryContext<Bits>& ctx,
+                 size_t teeth = 5)
+        : ctx_(ctx), base_(base), teeth_(std::min(std::max<size_t>(teeth, 1), MAX_WINDOW_BITS)) {
+        spacing_ = std::max<size_t>((max_exp_bits + teeth_ - 1) / teeth_, 1);
+
+        // row_powers[row] = base^(2^(row * spacing))
+        BigInt<Bits> row_powers[MAX_WINDOW_BITS];
+        row_powers[0] = ctx_.to_montgomery(base);
+        for (size_t row = 1; row < teeth_; ++row) {
+            row_powers[row] = row_powers[row - 1];
+            for (size_t s = 0; s < spacing_; ++s) {
+                row_powers[row] = ctx_.multiply(row_powers[row], row_powers[row]);
+            }
+        }
+
+        // table_[j] is the product of row_powers[row] for every set bit of j
+        table_.resize(size_t(1) << teeth_);
+        table_[0] = ctx_.one;
+        for (size_t j = 1; j < table_.size(); ++j) {
+            size_t row = __builtin_ctzll(j);
+            table_[j] = ctx_.multiply(table_[j & (j - 1)], row_powers[row]);
+        }
+    }
+
+    BigInt<Bits> pow(const BigInt<Bits>& exp) const {
+        // Exponents longer than the grid fall back to the sliding window
+        if (exp.bit_length() > teeth_ * spacing_) return mod_exp(base_, exp, ctx_);
+
+        CRYPTOALGS_COUNT(ModExpCalls, 1);
+        CRYPTOALGS_TIME_SCOPE(ModExp);
+        size_t multiplies = 0;
+        BigInt<Bits> result = ctx_.one;
+        for (size_t k = spacing_; k-- > 0;) {
+            result = ctx_.multiply(result, result);
+            size_t index = 0;
+            for (size_t row = 0; row < teeth_; ++row) {
+                // teeth * spacing can pass Bits (5 x 205 = 1025 at 1024 bits);
+                // positions past the top are zero bits
+                size_t position = row * spacing_ + k;
+                if (position < Bits) index |= static_cast<size_t>(exp.bit(position)) << row;
+            }
+#if CRYPTOALGS_CONSTANT_TIME
+            // Read every entry and always multiply (table_[0] is one)
+            BigInt<Bits> entry;
+            for (size_t j = 0; j < table_.size(); ++j) {
+                uint64_t match = ct_eq_mask(j, index);
+                for (size_t l = 0; l < BigInt<Bits>::LIMBS; ++l) entry.limbs[l] |= table_[j].limbs[l] & match;
+            }
+            result = ctx_.multiply(result, entry);
+            ++multiplies;
+#else
+            if (index != 0) {
+                result = ctx_.multiply(result, table_[index]);
+                ++multiplies;
+            }
+#endif
+        }
+        CRYPTOALGS_COUNT(ModExpSquarings, spacing_);
+        CRYPTOALGS_COUNT(ModExpMultiplies, multiplies);
+        return ctx_.from_montgomery(result);
+    }
+
+private:
+    MontgomeryContext<Bits> ctx_;
+    BigInt<Bits> base_;
+    size_t teeth_;
+    size_t spacing_;
+    std::vector<BigInt<Bits>> table_;
+};
+
+// Modular Exponentiation (base^exp % mod)
+// Odd moduli (every RSA modulus and prime) go through Montgomery; even ones
+// square and reduce by division on every step, so intermediates never exceed 2 * Bits.
+// The even-modulus path is variable-time in every build; no RSA secret takes it.
+template <size_t Bits>
+BigInt<Bits> mod_exp(BigInt<Bits> base, const BigInt<Bits>& exp, const BigInt<Bits>& mod) {
+    if (mod.is_odd() && mod != BigInt<Bits>(1)) {
+        return mod_exp(base, exp, MontgomeryContext<Bits>(mod));
+    }
+
+    CRYPTOALGS_COUNT(ModExpCalls, 1);
+    CRYPTOALGS_TIME_SCOPE(ModExp);
+    BigInt<Bits> result = BigInt<Bits>(1) % mod;
+    // base^exp % mod = (base%mod)^exp % mod
+    base = base % mod;
+
+    size_t bits = exp.bit_length();
+    size_t multiplies = 0;
+    for (size_t i = 0; i < bits; ++i) {
+        // If odd, multiply by base once
+        if (exp.bit(i)) {
+            result = mul_mod(result, base, mod);
+            ++multiplies;
+        }
+        // Include the square in the answer
+        base = mul_mod(base, base, mod);
+    }
+    CRYPTOALGS_COUNT(ModExpSquarings, bits);
+    CRYPTOALGS_COUNT(ModExpMultiplies, multiplies);
+    return result;
+}
+
+// Modular Inverse using Extended Euclidean Algorithm
+// Find co-prime numbers such that it returns d
+// where e * d % phi == 1. Returns 0 if e is not invertible.
+//
+// Lehmer's extended Euclid: the quotients of the leading 62 bits of r and
+// newr match the true quotients for several steps, so those steps are run
+// on single-limb values and collected in a 2x2 matrix (A B; C D), which is
+// then applied to the full-width values once. A full division step is only
+// taken when the leading bits cannot decide a single quotient.
+template <size_t Bits>
+BigInt<Bits> mod_inverse(const BigInt<Bits>& e, const BigInt<Bits>& phi) {
+    // The Bezout coefficients t alternate in sign, so only their magnitudes
+    // are tracked: |t_next| = |t_prev| + quotient * |t|
+    BigInt<Bits> t = 0, newt = 1;
+    BigInt<Bits> r = phi, newr = e % phi;
+    bool newt_negative = false;
+
+    // cx * x + cy * y, exact when the true result lies in [0, 2^Bits)
+    auto combine = [](const BigInt<Bits>& x, int64_t cx, const BigInt<Bits>& y, int64_t cy) {
+        BigInt<Bits> px = x, py = y;
+        px.mul_add_small(static_cast<uint64_t>(cx < 0 ? -cx : cx), 0);
+        py.mul_add_small(static_cast<uint64_t>(cy < 0 ? -cy : cy), 0);
+        BigInt<Bits> result = cx < 0 ? BigInt<Bits>() - px : px;
+        return cy < 0 ? result - py : result + py;
+    };
+
+    while (!newr.is_zero()) {
+        size_t length = r.bit_length();
+        size_t shift = length > 62 ? length - 62 : 0;
+        int64_t x = static_cast<int64_t>((r >> shift).limbs[0]);
+        int64_t y = static_cast<int64_t>((newr >> shift).limbs[0]);
+
+        // Knuth's algorithm L: step while both bounds give the same quotient
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        size_t steps = 0;
+        while (y + C != 0 && y + D != 0) {
+            int64_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D)) break;
+            int64_t next;
+            next = A - q * C; A = C; C = next;
+            next = B - q * D; B = D; D = next;
+            next = x - q * y; x = y; y = next;
+            ++steps;
+        }
+
+        if (B == 0) {
+            // No single-limb step was certain: one full division step
+            BigInt<Bits> quotient = r / newr;
+            BigInt<Bits> temp = newt;
+            newt = t + quotient * newt;
+            t = temp;
+            newt_negative = !newt_negative;
+
+            temp = newr;
+            newr = r - quotient * newr;
+            r = temp;
+            continue;
+        }
+
+        BigInt<Bits> next_r = combine(r, A, newr, B);
+        newr = combine(r, C, newr, D);
+        r = next_r;
+
+        // The matrix is a product of Euclid steps, so its entries alternate
+        // in sign against those of t and newt and the magnitudes add
+        auto magnitude = [](int64_t value) { return static_cast<uint64_t>(value < 0 ? -value : value); };
+        BigInt<Bits> at = t, bt = newt, ct = t, dt = newt;
+        at.mul_add_small(magnitude(A), 0);
+        bt.mul_add_small(magnitude(B), 0);
+        ct.mul_add_small(magnitude(C), 0);
+        dt.mul_add_small(magnitude(D), 0);
+        t = at + bt;
+        newt = ct + dt;
+        if (steps % 2 != 0) newt_negative = !newt_negative;
+    }
+
+    if (r != BigInt<Bits>(1)) return BigInt<Bits>(); // e is not invertible
+    // t is one step behind newt, so it has the opposite sign
+    if (!newt_negative && !t.is_zero()) t = phi - t;
+    return t;
+}
+
+// a^-1 mod m for odd m and a < m, constant time: a fixed 2 * Bits steps of
+// binary extended GCD (Stein), every conditional swap and subtraction done
+// through masks. Invariants u = r * a and v = s * a (mod m); each step makes
+// u even by subtracting v (swapping first so u >= v), then halves u and r.
+template <size_t Bits>
+BigInt<Bits> mod_inverse_odd_ct(const BigInt<Bits>& a, const BigInt<Bits>& m) {
+    constexpr size_t N = BigInt<Bits>::LIMBS;
+    BigInt<Bits> u = a, v = m, r = 1, s = 0, scratch;
+    for (size_t step = 0; step < 2 * Bits; ++step) {
+        uint64_t odd = 0 - (u.limbs[0] & 1);
+        uint64_t less = 0 - sub_limbs(scratch.limbs, u.limbs, v.limbs, N);
+        swap_limbs_masked(u.limbs, v.limbs, odd & less, N);
+        swap_limbs_masked(r.limbs, s.limbs, odd & less, N);
+
+        sub_limbs_masked(u.limbs, v.limbs, odd, N);
+        uint64_t borrow = sub_limbs_masked(r.limbs, s.limbs, odd, N);
+        add_limbs_masked(r.limbs, m.limbs, 0 - borrow, N);
+
+        // u /= 2; r = r / 2 mod m (add m first when r is odd, keeping the carry)
+        u >>= 1;
+        uint64_t carry = add_limbs_masked(r.limbs, m.limbs, 0 - (r.limbs[0] & 1), N);
+        r >>= 1;
+        r.limbs[N - 1] |= carry << 63;
+    }
+    // v holds gcd(a, m)
+    uint64_t not_one = v.limbs[0] ^ 1;
+    for (size_t i = 1; i < N; ++i) not_one |= v.limbs[i];
+    uint64_t invertible = 0 - static_cast<uint64_t>(not_one == 0);
+    for (size_t i = 0; i < N; ++i) s.limbs[i] &= invertible;
+    return s;
+}
+
+// a mod m for secret a and m (m below 2^(Bits - 1)), constant time: binary
+// long division over every bit of a, each subtraction of m done through a
+// mask. Serves even moduli such as p - 1, which Montgomery reduction cannot.
+template <size_t Bits>
+BigInt<Bits> mod_reduce_ct(const BigInt<Bits>& a, const BigInt<Bits>& m) {
+    constexpr size_t N = BigInt<Bits>::LIMBS;
+    BigInt<Bits> r, scratch;
+    for (size_t i = Bits; i-- > 0;) {
+        r <<= 1;
+        r.limbs[0] |= (a.limbs[i / 64] >> (i % 64)) & 1;
+        uint64_t below = 0 - sub_limbs(scratch.limbs, r.limbs, m.limbs, N);
+        sub_limbs_masked(r.limbs, m.limbs, ~below, N);
+    }
+    return r;
+}
+
+// Constant-time option of mod_inverse for secret values. Needs m odd, or a
+// odd with an even m (as for d = e^-1 mod phi); then with y = m^-1 mod a,
+// a^-1 mod m = (1 + m * (a - y)) / a, where only the division by the
+// (public, for RSA) a is variable-time. Returns 0 if a is not invertible.
+template <size_t Bits>
+BigInt<Bits> mod_inverse_ct(const BigInt<Bits>& a, const BigInt<Bits>& m) {
+    if (m.is_odd()) return mod_inverse_odd_ct(a % m, m);
+    if (!a.is_odd()) return BigInt<Bits>();
+    if (a == BigInt<Bits>(1)) return a; // y = m^-1 mod 1 is 0, not a failure
+
+    BigInt<Bits> y = mod_inverse_odd_ct(m % a, a);
+    if (y.is_zero()) return BigInt<Bits>();
+    BigInt<2 * Bits> numerator = bigint_cast<2 * Bits>(m) * bigint_cast<2 * Bits>(a - y) + BigInt<2 * Bits>(1);
+    return bigint_cast<Bits>(numerator / bigint_cast<2 * Bits>(a));
+}
+
+// --- RSA Keys ---
+
+template <size_t Bits>
+struct RsaPublicKey {
+    BigInt<Bits> n;
+    BigInt<Bits> e;
+    MontgomeryContext<Bits> n_ctx;
+
+    RsaPublicKey(const BigInt<Bits>& modulus, const BigInt<Bits>& exponent)
+        : n(modulus), e(exponent), n_ctx(modulus) {}
+};
+
+// Private key that keeps the factors (PKCS #1 form), so decryption can run
+// modulo p and q separately (Chinese Remainder Theorem). The primes are half
+// the modulus width, and so are the two exponentiations.
+template <size_t Bits>
+struct RsaPrivateKey {
+    static_assert(Bits % 128 == 0, "RSA modulus width must split into two limb-aligned halves");
+    using Half = BigInt<Bits / 2>;
+
+    Half p;
+    Half q;
+    BigInt<Bits> n;
+    BigInt<Bits> e;
+    BigInt<Bits> d;
+    Half dP;   // d mod (p - 1)
+    Half dQ;   // d mod (q - 1)
+    Half qInv; // q^-1 mod p
+    MontgomeryContext<Bits / 2> p_ctx;
+    MontgomeryContext<Bits / 2> q_ctx;
+
+    // Builds the key from two distinct odd primes; e is the smallest value
+    // from first_e up that is coprime to phi(n)
+    RsaPrivateKey(const Half& prime_p, const Half& prime_q, uint64_t first_e = 17)
+        : p(prime_p), q(prime_q),
+          n(bigint_cast<Bits>(prime_p) * bigint_cast<Bits>(prime_q)),
+          p_ctx(prime_p), q_ctx(prime_q) {
+        // Compute phi(n)
+        BigInt<Bits> p_minus_1 = bigint_cast<Bits>(p - 1);
+        BigInt<Bits> q_minus_1 = bigint_cast<Bits>(q - 1);
+        BigInt<Bits> phi = p_minus_1 * q_minus_1;
+
+#if CRYPTOALGS_CONSTANT_TIME
+        // Choose e and d together: the constant-time inverse returns 0 for
+        // each e that shares a factor with phi, so gcd never sees phi
+        e = first_e;
+        while ((d = mod_inverse_ct(e, phi)).is_zero())
+            e += 1;
+        dP = bigint_cast<Bits / 2>(mod_reduce_ct(d, p_minus_1));
+        dQ = bigint_cast<Bits / 2>(mod_reduce_ct(d, q_minus_1));
+#else
+        // Choose e (public key exponent)
+        e = first_e;
+        while (gcd(e, phi) != BigInt<Bits>(1))
+            e += 1;
+
+        // Compute d (private key exponent) and the CRT components
+        d = mod_inverse_ct(e, phi);
+        if (d.is_zero()) throw std::invalid_argument("failed to find modular inverse");
+        dP = bigint_cast<Bits / 2>(d % p_minus_1);
+        dQ = bigint_cast<Bits / 2>(d % q_minus_1);
+#endif
+        qInv = mod_inverse_ct(q, p);
+        if (qInv.is_zero()) throw std::invalid_argument("RSA primes must be distinct");
+    }
+
+    RsaPublicKey<Bits> public_key() const { return RsaPublicKey<Bits>(n, e); }
+};
+
+// Garner's recombination of the two halves (variable-time):
+//   h = qInv * (m1 - m2) mod p, kept non-negative, m = m2 + h * q
+template <size_t Bits>
+BigInt<Bits> crt_recombine(const BigInt<Bits / 2>& m1, const BigInt<Bits / 2>& m2, const RsaPrivateKey<Bits>& key) {
+    BigInt<Bits / 2> m2_mod_p = m2 % key.p;
+    BigInt<Bits / 2> diff = m1 >= m2_mod_p ? m1 - m2_mod_p : m1 + (key.p - m2_mod_p);
+    BigInt<Bits / 2> h = mul_mod(key.qInv, diff, key.p);
+    return bigint_cast<Bits>(m2) + bigint_cast<Bits>(h) * bigint_cast<Bits>(key.q);
+}
+
+// m = c^d mod n through the CRT (Garner's recombination):
+//   m1 = c^dP mod p, m2 = c^dQ mod q, h = qInv * (m1 - m2) mod p, m = m2 + h * q
+// The two half-size exponentiations are independent; with parallel set the
+// p half runs on a second thread.
+//
+// The constant-time build never divides by a prime: c is reduced straight
+// into Montgomery form, m1 stays there for the subtraction, and
+// REDC((m1 - m2) R, qInv) leaves h in normal form.
+template <size_t Bits>
+BigInt<Bits> rsa_decrypt_crt(const BigInt<Bits>& c, const RsaPrivateKey<Bits>& key, bool parallel = false) {
+    using Half = BigInt<Bits / 2>;
+#if CRYPTOALGS_CONSTANT_TIME
+    auto half_exp = [&c](const Half& exponent, const MontgomeryContext<Bits / 2>& ctx) {
+        CRYPTOALGS_COUNT(ModExpCalls, 1);
+        CRYPTOALGS_TIME_SCOPE(ModExp);
+        return montgomery_ladder(ctx.to_montgomery_ct(c), exponent, ctx);
+    };
+#else
+    auto half_exp = [&c](const Half& exponent, const MontgomeryContext<Bits / 2>& ctx) {
+        return mod_exp(reduce(c, ctx.modulus), exponent, ctx);
+    };
+#endif
+
+    Half m1, m2;
+    if (parallel) {
+        std::future<Half> p_half = std::async(std::launch::async, half_exp, std::cref(key.dP), std::cref(key.p_ctx));
+        m2 = half_exp(key.dQ, key.q_ctx);
+        m1 = p_half.get();
+    } else {
+        m1 = half_exp(key.dP, key.p_ctx);
+        m2 = half_exp(key.dQ, key.q_ctx);
+    }
+
+#if CRYPTOALGS_CONSTANT_TIME
+    // m1 and m2 mod p in Montgomery form, diff = (m1 - m2) R mod p through a masked add of p
+    constexpr size_t HL = Half::LIMBS;
+    m2 = key.q_ctx.from_montgomery(m2);
+    Half m2_mod_p = key.p_ctx.to_montgomery_ct(m2);
+    Half diff;
+    uint64_t borrow = sub_limbs(diff.limbs, m1.limbs, m2_mod_p.limbs, HL);
+    add_limbs_masked(diff.limbs, key.p.limbs, ct_bit_mask(borrow), HL);
+    Half h = key.p_ctx.multiply(diff, key.qInv);
+
+    // m = m2 + h * q over the full limb count (no trimming of leading zero limbs)
+    BigInt<Bits> m;
+    mul_limbs(m.limbs, h.limbs, HL, key.q.limbs, HL);
+    BigInt<Bits> m2_wide = bigint_cast<Bits>(m2);
+    add_limbs(m.limbs, m.limbs, m2_wide.limbs, BigInt<Bits>::LIMBS);
+    return m;
+#else
+    return crt_recombine(m1, m2, key);
+#endif
+}
+
+// rsa_decrypt_crt over a batch under one key: the p and q halves each go
+// through mod_exp_batch, so the IFMA engine takes eight ciphertexts at a
+// time, and every result is recombined on its own. The constant-time build
+// keeps the ladder and decrypts one by one. out may alias c.
+template <size_t Bits>
+void rsa_decrypt_crt_batch(const BigInt<Bits>* c, BigInt<Bits>* out, size_t count, const RsaPrivateKey<Bits>& key) {
+#if CRYPTOALGS_CONSTANT_TIME
+    for (size_t i = 0; i < count; ++i) out[i] = rsa_decrypt_crt(c[i], key);
+#else
+    using Half = BigInt<Bits / 2>;
+    std::vector<Half> m1(count), m2(count);
+    for (size_t i = 0; i < count; ++i) {
+        m1[i] = reduce(c[i], key.p);
+        m2[i] = reduce(c[i], key.q);
+    }
+    mod_exp_batch(m1.data(), m1.data(), count, key.dP, key.p_ctx);
+    mod_exp_batch(m2.data(), m2.data(), count, key.dQ, key.q_ctx);
+    for (size_t i = 0; i < count; ++i) out[i] = crt_recombine(m1[i], m2[i], key);
+#endif
+}
+
+// Public-key operation on a batch under one key: c = m^e mod n for
+// encryption, or s^e mod n when checking signatures against their messages
+template <size_t Bits>
+void rsa_public_batch(const BigInt<Bits>* inputs, BigInt<Bits>* outputs, size_t count, const RsaPublicKey<Bits>& key) {
+    mod_exp_batch(inputs, outputs, count, key.e, key.n_ctx);
+}
+
+// Verifies count (message, signature) pairs; valid[i] is set per pair and
+// the number of valid signatures is returned
+template <size_t Bits>
+size_t rsa_verify_batch(const BigInt<Bits>* messages, const BigInt<Bits>* signatures, size_t count,
+                        const RsaPublicKey<Bits>& key, bool* valid) {
+    std::vector<BigInt<Bits>> recovered(count);
+    rsa_public_batch(signatures, recovered.data(), count, key);
+    size_t matches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        valid[i] = recovered[i] == messages[i];
+        matches += valid[i];
+    }
+    return matches;
+}
+
+// Encrypt string message to vector of ciphertext integers
+template <size_t Bits>
+std::vector<BigInt<Bits>> encrypt_string(const std::string& message, const BigInt<Bits>& e, const BigInt<Bits>& n) {
+    MontgomeryContext<Bits> ctx(n);
+    std::vector<BigInt<Bits>> encrypted;
+    encrypted.reserve(message.size());
+    for (char ch : message) {
+        BigInt<Bits> m = static_cast<uint8_t>(ch);
+        encrypted.push_back(mod_exp_vartime(m, e, ctx));
+    }
+    return encrypted;
+}
+
+// Decrypt vector of ciphertext to string
+template <size_t Bits>
+std::string decrypt_string(const std::vector<BigInt<Bits>>& encrypted, const BigInt<Bits>& d, const BigInt<Bits>& n) {
+    MontgomeryContext<Bits> ctx(n);
+    std::string decrypted;
+    decrypted.reserve(encrypted.size());
+    for (const BigInt<Bits>& c : encrypted) {
+        BigInt<Bits> m = mod_exp(c, d, ctx);
+        decrypted += static_cast<char>(m.limbs[0]);
+    }
+    return decrypted;
+}
+
+// Decrypt vector of ciphertext to string with the CRT private key
+template <size_t Bits>
+std::string decrypt_string(const std::vector<BigInt<Bits>>& encrypted, const RsaPrivateKey<Bits>& key) {
+    std::string decrypted;
+    decrypted.reserve(encrypted.size());
+    for (const BigInt<Bits>& c : encrypted) {
+        decrypted += static_cast<char>(rsa_decrypt_crt(c, key).limbs[0]);
+    }
+    return decrypted;
+}
+
+// --- Key Generation ---
+// Random probable primes: a random odd start x is sieved over the window
+// x, x + 2, ..., x + 2(W - 1) by the odd primes below SIEVE_LIMIT (the
+// marking of utils.py's sieve_of_eratosthenes, offset to start at x), and
+// only the survivors (about 1 in 9) pay for Miller-Rabin. Threads search
+// independent windows until two primes are found.
+
+inline constexpr uint32_t SIEVE_LIMIT = 1 << 14;
+inline constexpr size_t SIEVE_WINDOW = 4096;
+
+// Fills bytes from the OS CSPRNG (getrandom on Linux, std::random_device
+// elsewhere). Prime candidates, Miller-Rabin bases and padding come from
+// here, never from the MT19937 generator behind des_generate_iv: IVs are
+// sent in the clear, and 624 MT19937 outputs give away its state.
+void secure_random_fill(uint8_t* bytes, size_t length);
+
+// Odd primes up to SIEVE_LIMIT
+const std::vector<uint32_t>& small_primes();
+
+// Uniform value below 2^bits
+template <size_t Bits>
+BigInt<Bits> random_bits(size_t bits) {
+    BigInt<Bits> value;
+    secure_random_fill(reinterpret_cast<uint8_t*>(value.limbs), 8 * ((bits + 63) / 64));
+    if (bits % 64 != 0) value.limbs[bits / 64] &= (uint64_t(1) << (bits % 64)) - 1;
+    return value;
+}
+
+// Rounds for a random candidate of this size (error well below 2^-80)
+inline size_t miller_rabin_rounds(size_t bits) {
+    if (bits >= 1024) return 5;
+    if (bits >= 512) return 8;
+    if (bits >= 256) return 12;
+    return 20;
+}
+
+// Miller-Rabin with random bases on the odd modulus of ctx. The squarings
+// stay in Montgomery form, where -1 is n - R mod n.
+template <size_t Bits>
+bool miller_rabin(const MontgomeryContext<Bits>& ctx, size_t rounds) {
+    const BigInt<Bits>& n = ctx.modulus;
+    BigInt<Bits> n_minus_1 = n - 1;
+    size_t s = 0;
+    while (!n_minus_1.bit(s)) ++s;
+    BigInt<Bits> d = n_minus_1 >> s;
+    BigInt<Bits> minus_one = n - ctx.one;
+    size_t bits = n.bit_length();
+
+    for (size_t round = 0; round < rounds; ++round) {
+        BigInt<Bits> a = random_bits<Bits>(bits - 1);
+        if (a < BigInt<Bits>(2)) a = BigInt<Bits>(2);
+        BigInt<Bits> x = ctx.to_montgomery(mod_exp(a, d, ctx));
+        if (x == ctx.one || x == minus_one) continue;
+        bool composite = true;
+        for (size_t i = 1; i < s && composite; ++i) {
+            x = ctx.multiply(x, x);
+            composite = x != minus_one;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// Searches random windows of bits-bit candidates with the top two bits set
+// (so a product of two has exactly 2 * bits bits). Candidates with
+// p = 1 (mod e) are skipped, which for prime e keeps e coprime to p - 1.
+// Returns false if stop was raised before a prime was found.
+template <size_t Bits>
+bool search_prime(size_t bits, uint64_t e, const std::atomic<bool>& stop, BigInt<Bits>& prime) {
+    const std::vector<uint32_t>& primes = small_primes();
+    std::vector<uint8_t> sieve(SIEVE_WINDOW);
+    size_t rounds = miller_rabin_rounds(bits);
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        BigInt<Bits> start = random_bits<Bits>(bits);
+        start.limbs[(bits - 1) / 64] |= uint64_t(1) << ((bits - 1) % 64);
+        start.limbs[(bits - 2) / 64] |= uint64_t(1) << ((bits - 2) % 64);
+        start.limbs[0] |= 1;
+
+        // sieve[i] marks start + 2i as having a small factor
+        std::fill(sieve.begin(), sieve.end(), 0);
+        for (uint32_t p : primes) {
+            uint64_t r = start.mod_small(p);
+            uint64_t i = r == 0 ? 0 : (p - r) * ((p + 1) / 2) % p; // (-r) * 2^-1 mod p
+            for (; i < SIEVE_WINDOW; i += p) sieve[i] = 1;
+        }
+
+        for (size_t i = 0; i < SIEVE_WINDOW && !stop.load(std::memory_order_relaxed); ++i) {
+            if (sieve[i]) continue;
+            BigInt<Bits> candidate = start + BigInt<Bits>(2 * i);
+            if (candidate.bit_length() != bits) break;
+            if (e > 1 && candidate.mod_small(e) == 1) continue;
+            if (miller_rabin(MontgomeryContext<Bits>(candidate), rounds)) {
+                prime = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Random RSA key whose modulus has exactly bits bits (even, 64..Bits),
+// starting the public exponent search at e. threads == 0 uses every core.
+template <size_t Bits>
+RsaPrivateKey<Bits> generate_keypair(size_t bits = Bits, unsigned threads = 0, uint64_t e = 65537) {
+    using Half = typename RsaPrivateKey<Bits>::Half;
+    if (bits % 2 != 0 || bits < 64 || bits > Bits) {
+        throw std::invalid_argument("RSA key size must be even and between 64 and the modulus width");
+    }
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::atomic<bool> stop{false};
+    std::mutex found_lock;
+    std::vector<Half> found;
+    auto worker = [&] {
+        Half prime;
+        while (search_prime(bits / 2, e, stop, prime)) {
+            std::lock_guard<std::mutex> guard(found_lock);
+            if (found.size() < 2 && (found.empty() || found[0] != prime)) found.push_back(prime);
+            if (found.size() == 2) stop = true;
+        }
+    };
+
+    std::vector<std::future<void>> helpers;
+    for (unsigned i = 1; i < threads; ++i) helpers.push_back(std::async(std::launch::async, worker));
+    worker();
+    for (auto& helper : helpers) helper.get();
+    return RsaPrivateKey<Bits>(found[0], found[1], e);
+}
+
+// --- Block Encoding (PKCS #1 v1.5) ---
+// Packs a byte message into blocks the size of the modulus instead of one
+// exponentiation per character. With k = byte length of n, each block is
+//   EM = 0x00 || 0x02 || PS || 0x00 || M
+// where PS is at least 8 random non-zero bytes, so up to k - 11 message
+// bytes fit per block and each ciphertext block is exactly k bytes.
+
+inline constexpr size_t PKCS1_OVERHEAD = 11;
+
+// Non-zero padding bytes: one bulk fill, then redraw the zeros
+inline void fill_nonzero_random(uint8_t* bytes, size_t length) {
+    secure_random_fill(bytes, length);
+    for (size_t i = 0; i < length; ++i) {
+        while (bytes[i] == 0) secure_random_fill(bytes + i, 1);
+    }
+}
+
+template <size_t Bits>
+size_t rsa_block_bytes(const BigInt<Bits>& n) {
+    return (n.bit_length() + 7) / 8;
+}
+
+// Ciphertext size for a message of length bytes
+template <size_t Bits>
+size_t rsa_encrypted_size(size_t length, const RsaPublicKey<Bits>& key) {
+    size_t k = rsa_block_bytes(key.n);
+    size_t per_block = k - PKCS1_OVERHEAD;
+    size_t blocks = length == 0 ? 1 : (length + per_block - 1) / per_block;
+    return blocks * k;
+}
+
+// Appends the ciphertext to out, reserving its full size up front
+template <size_t Bits>
+void rsa_encrypt_bytes(const uint8_t* message, size_t length, const RsaPublicKey<Bits>& key,
+                       std::vector<uint8_t>& out) {
+    size_t k = rsa_block_bytes(key.n);
+    if (k <= PKCS1_OVERHEAD) throw std::invalid_argument("RSA modulus too small for PKCS #1 padding");
+    size_t per_block = k - PKCS1_OVERHEAD;
+    size_t offset = out.size();
+    out.resize(offset + rsa_encrypted_size(length, key));
+
+    uint8_t encoded[Bits / 8];
+    size_t consumed = 0;
+    do {
+        size_t chunk = std::min(per_block, length - consumed);
+        size_t padding = k - 3 - chunk;
+        encoded[0] = 0x00;
+        encoded[1] = 0x02;
+        fill_nonzero_random(encoded + 2, padding);
+        encoded[2 + padding] = 0x00;
+        std::copy(message + consumed, message + consumed + chunk, encoded + 3 + padding);
+
+        // Encrypt: c = m^e mod n
+        BigInt<Bits> m = BigInt<Bits>::from_bytes(encoded, k);
+        mod_exp_vartime(m, key.e, key.n_ctx).to_bytes(out.data() + offset, k);
+        offset += k;
+        consumed += chunk;
+    } while (consumed < length);
+}
+
+// Appends the recovered message bytes to out. Returns false if the length
+// is not a whole number of blocks or a block's padding is malformed, and
+// then leaves out as it was (no plaintext of the blocks before the bad one).
+template <size_t Bits>
+bool rsa_decrypt_bytes(const uint8_t* ciphertext, size_t length, const RsaPrivateKey<Bits>& key,
+                       std::vector<uint8_t>& out) {
+    size_t k = rsa_block_bytes(key.n);
+    if (k <= PKCS1_OVERHEAD || length == 0 || length % k != 0) return false;
+    size_t original_size = out.size();
+    auto fail = [&out, original_size] {
+        out.resize(original_size);
+        return false;
+    };
+    out.reserve(original_size + (length / k) * (k - PKCS1_OVERHEAD));
+
+    uint8_t encoded[Bits / 8];
+    for (size_t offset = 0; offset < length; offset += k) {
+        // Decrypt: m = c^d mod n
+        BigInt<Bits> c = BigInt<Bits>::from_bytes(ciphertext + offset, k);
+        if (c >= key.n) return fail();
+        rsa_decrypt_crt(c, key).to_bytes(encoded, k);
+
+#if CRYPTOALGS_CONSTANT_TIME
+        // One pass over every byte; only the overall verdict is branched on
+        uint64_t valid = ct_eq_mask(encoded[0], 0x00) & ct_eq_mask(encoded[1], 0x02);
+        uint64_t found = 0;
+        uint64_t separator = 0;
+        for (size_t i = 2; i < k; ++i) {
+            uint64_t first_zero = ct_eq_mask(encoded[i], 0x00) & ~found;
+            separator = ct_select(first_zero, i, separator);
+            found |= first_zero;
+        }
+        valid &= found & ~ct_bit_mask((separator - (2 + 8)) >> 63);
+        if (valid == 0) return fail();
+#else
+        if (encoded[0] != 0x00 || encoded[1] != 0x02) return fail();
+        size_t separator = 2;
+        while (separator < k && encoded[separator] != 0x00) ++separator;
+        if (separator == k || separator < 2 + 8) return fail();
+#endif
+        out.insert(out.end(), encoded + separator + 1, encoded + k);
+    }
+    return true;
+}
+
+// --- Standard Sizes ---
+// The widths below are instantiated once in the library instead of in every
+// unit that includes this header; any other width still instantiates
+// implicitly. Arithmetic covers the moduli and their CRT halves, keys the
+// modulus widths. An LTO build can inline the library copies into callers.
+
+#define RSA_ARITHMETIC_TEMPLATES(PREFIX, B)                                                                  \
+    PREFIX template struct BigInt<B>;                                                                        \
+    PREFIX template struct MontgomeryContext<B>;                                                             \
+    PREFIX template BigInt<B> gcd<B>(BigInt<B>, BigInt<B>);                                                  \
+    PREFIX template BigInt<B> mod_exp<B>(const BigInt<B>&, const BigInt<B>&, const MontgomeryContext<B>&,    \
+                                         size_t);                                                            \
+    PREFIX template BigInt<B> mod_exp_vartime<B>(const BigInt<B>&, const BigInt<B>&,                         \
+                                                 const MontgomeryContext<B>&, size_t);                       \
+    PREFIX template BigInt<B> mod_exp_ladder<B>(const BigInt<B>&, const BigInt<B>&,                          \
+                                                const MontgomeryContext<B>&);                                \
+    PREFIX template BigInt<B> mod_exp<B>(BigInt<B>, const BigInt<B>&, const BigInt<B>&);                     \
+    PREFIX template void mod_exp_batch<B>(const BigInt<B>*, BigInt<B>*, size_t, const BigInt<B>&,            \
+                                          const MontgomeryContext<B>&, size_t);                              \
+    PREFIX template BigInt<B> mod_inverse<B>(const BigInt<B>&, const BigInt<B>&);                            \
+    PREFIX template BigInt<B> mod_reduce_ct<B>(const BigInt<B>&, const BigInt<B>&);                          \
+    PREFIX template BigInt<B> mod_inverse_ct<B>(const BigInt<B>&, const BigInt<B>&);                         \
+    PREFIX template bool miller_rabin<B>(const MontgomeryContext<B>&, size_t);                               \
+    PREFIX template bool search_prime<B>(size_t, uint64_t, const std::atomic<bool>&, BigInt<B>&);
+
+#define RSA_KEY_TEMPLATES(PREFIX, B)                                                                         \
+    PREFIX template struct RsaPublicKey<B>;                                                                  \
+    PREFIX template struct RsaPrivateKey<B>;                                                                 \
+    PREFIX template BigInt<B> rsa_decrypt_crt<B>(const BigInt<B>&, const RsaPrivateKey<B>&, bool);           \
+    PREFIX template void rsa_decrypt_crt_batch<B>(const BigInt<B>*, BigInt<B>*, size_t,                      \
+                                                  const RsaPrivateKey<B>&);                                  \
+    PREFIX template void rsa_public_batch<B>(const BigInt<B>*, BigInt<B>*, size_t, const RsaPublicKey<B>&);  \
+    PREFIX template size_t rsa_verify_batch<B>(const BigInt<B>*, const BigInt<B>*, size_t,                   \
+                                               const RsaPublicKey<B>&, bool*);                               \
+    PREFIX template RsaPrivateKey<B> generate_keypair<B>(size_t, unsigned, uint64_t);                        \
+    PREFIX template void rsa_encrypt_bytes<B>(const uint8_t*, size_t, const RsaPublicKey<B>&,                \
+                                              std::vector<uint8_t>&);                                        \
+    PREFIX template bool rsa_decrypt_bytes<B>(const uint8_t*, size_t, const RsaPrivateKey<B>&,               \
+                                              std::vector<uint8_t>&);
+
+#define RSA_STANDARD_TEMPLATES(PREFIX)      \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 512)   \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 1024)  \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 1536)  \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 2048)  \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 3072)  \
+    RSA_ARITHMETIC_TEMPLATES(PREFIX, 4096)  \
+    RSA_KEY_TEMPLATES(PREFIX, 1024)         \
+    RSA_KEY_TEMPLATES(PREFIX, 2048)         \
+    RSA_KEY_TEMPLATES(PREFIX, 3072)         \
+    RSA_KEY_TEMPLATES(PREFIX, 4096)
+
+RSA_STANDARD_TEMPLATES(extern)
@@ -0,0 +1,398 @@
+// DES block engines: the bit-sliced passes and the run-time engine choice.
+// Everything else in des.hpp is inline.
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "des.hpp"
+
+// --- Bit-Sliced Engine ---
+// Processes many independent blocks at once: blocks are transposed so that
+// slice b holds DES bit b+1 of every block (one block per bit of the word),
+// which turns IP, E, P and IP_INV into plain renaming of slices and the round
+// keys into all-zero/all-one masks. Only the S-boxes do real work; each
+// output bit is evaluated as a multiplexer tree over the six input slices,
+// with the truth table taken from S_BOXES at compile time, so the circuit is
+// constant-folded per S-box. The lane type sets the pass width: uint64_t runs
+// 64 blocks, and the GCC/Clang vector types run 128/256/512 blocks per pass
+// (SSE2 or NEON, AVX2, AVX-512). Each width gets a thin wrapper compiled for
+// its instruction set and the widest one the CPU supports is picked at run time.
+//
+// The keyed passes take a separate key per block: the 56 PC-1 key bits are
+// transposed into slices like the data, and since every round key is a fixed
+// selection of those bits, the round keys become renamings of the key slices
+// too. Blocks under different keys and in either direction share one pass.
+
+#if defined(__GNUC__)
+#define DES_HAVE_BITSLICE 1
+#define DES_BITSLICE_INLINE inline __attribute__((always_inline))
+#if defined(__x86_64__) || defined(__i386__)
+#define DES_HAVE_X86_DISPATCH 1
+#endif
+#endif
+
+namespace {
+
+#if DES_HAVE_BITSLICE
+
+typedef uint64_t Slice128 __attribute__((vector_size(16)));
+typedef uint64_t Slice256 __attribute__((vector_size(32)));
+typedef uint64_t Slice512 __attribute__((vector_size(64)));
+
+// Truth table for output bit j (0 = most significant) of S-box i: bit v is the output for 6-bit input v
+constexpr std::array<std::array<uint64_t, 4>, 8> build_s_box_truth_tables() {
+    std::array<std::array<uint64_t, 4>, 8> tables{};
+    for (int i = 0; i < 8; ++i) {
+        for (int v = 0; v < 64; ++v) {
+            int row = ((v >> 4) & 0x2) | (v & 0x1);
+            int col = (v >> 1) & 0xF;
+            for (int j = 0; j < 4; ++j) {
+                uint64_t bit = (S_BOXES[i][row][col] >> (3 - j)) & 1;
+                tables[i][j] |= bit << v;
+            }
+        }
+    }
+    return tables;
+}
+
+constexpr std::array<std::array<uint64_t, 4>, 8> S_BOX_TRUTH_TABLES = build_s_box_truth_tables();
+
+// Position in the P output that S output bit k (0-based) is moved to
+constexpr std::array<int, 32> build_p_inverse() {
+    std::array<int, 32> inverse{};
+    for (int i = 0; i < 32; ++i) {
+        inverse[P_TABLE[i] - 1] = i;
+    }
+    return inverse;
+}
+
+constexpr std::array<int, 32> P_INVERSE = build_p_inverse();
+
+// Bit of the PC-1 output (0 = most significant of 56) that bit k of
+// encryption round key r is drawn from: C and D are rotated left by the
+// shifts so far, then PC-2 picks 48 positions
+constexpr std::array<std::array<uint8_t, 48>, 16> build_round_key_sources() {
+    std::array<std::array<uint8_t, 48>, 16> sources{};
+    int shift = 0;
+    for (int r = 0; r < 16; ++r) {
+        shift += SHIFT_SCHEDULE[r];
+        for (int k = 0; k < 48; ++k) {
+            int position = PC2_TABLE[k] - 1;
+            int half = position < 28 ? 0 : 28;
+            sources[r][k] = static_cast<uint8_t>(half + (position - half + shift) % 28);
+        }
+    }
+    return sources;
+}
+
+constexpr std::array<std::array<uint8_t, 48>, 16> ROUND_KEY_SOURCES = build_round_key_sources();
+
+// Transposes a 64x64 bit matrix in place (row i bit 63-j <-> row j bit 63-i)
+void transpose64(uint64_t rows[64]) {
+    uint64_t mask = 0x00000000FFFFFFFFull;
+    for (int width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+        for (int k = 0; k < 64; k = ((k | width) + 1) & ~width) {
+            uint64_t t = (rows[k] ^ (rows[k | width] >> width)) & mask;
+            rows[k] ^= t;
+            rows[k | width] ^= t << width;
+        }
+    }
+}
+
+// Evaluates entries [Offset, Offset + 2^Bits) of a truth table, choosing
+// between the two halves on input bit 6 - Bits (x[0] is the most significant).
+// Lanes go through pointers/references so no wide vector crosses a call ABI.
+template <typename Lane, uint64_t Table, int Bits, int Offset>
+DES_BITSLICE_INLINE void s_box_mux(const Lane* x, Lane& result) {
+    if constexpr (Bits == 1) {
+        constexpr bool low = (Table >> Offset) & 1;
+        constexpr bool high = (Table >> (Offset + 1)) & 1;
+        const Lane zero{};
+        if constexpr (low == high) {
+            result = low ? ~zero : zero;
+        } else if constexpr (high) {
+            result = x[5];
+        } else {
+            result = ~x[5];
+        }
+    } else {
+        Lane low, high;
+        s_box_mux<Lane, Table, Bits - 1, Offset>(x, low);
+        s_box_mux<Lane, Table, Bits - 1, Offset + (1 << (Bits - 1))>(x, high);
+        result = low ^ ((low ^ high) & x[6 - Bits]);
+    }
+}
+
+// One S-box output bit, XORed into its permuted position of the left half
+template <typename Lane, int Box, int Bit>
+DES_BITSLICE_INLINE void bitslice_s_box_bit(const Lane* x, Lane* left) {
+    Lane output;
+    s_box_mux<Lane, S_BOX_TRUTH_TABLES[Box][Bit], 6, 0>(x, output);
+    left[P_INVERSE[4 * Box + Bit]] ^= output;
+}
+
+// Round keys shared by every block: each key bit is an all-zero/all-one mask
+template <typename Lane>
+struct SharedRoundKeys {
+    const uint64_t* round_keys;
+    uint64_t current = 0;
+
+    DES_BITSLICE_INLINE void start_round(int round) { current = round_keys[round]; }
+
+    // x = data ^ key bit index of the round
+    DES_BITSLICE_INLINE void mix(int index, const Lane& data, Lane& x) const {
+        const Lane zero{};
+        x = data ^ (zero - ((current >> (47 - index)) & 1));
+    }
+};
+
+// A key per block: slices 0..55 hold the PC-1 bits of every block and slice
+// 56 is all ones in the blocks that decrypt (which take the rounds last to
+// first)
+template <typename Lane>
+struct LaneRoundKeys {
+    Lane slices[57];
+    Lane current[48]; // this round's key bits
+
+    DES_BITSLICE_INLINE explicit LaneRoundKeys(const DesLaneKey* keys) {
+        constexpr size_t groups = sizeof(Lane) / sizeof(uint64_t);
+        alignas(64) uint64_t words[57 * groups];
+        for (size_t g = 0; g < groups; ++g) {
+            // Key bit j of a block lands in bit 63 - j of its row, as data bit j does
+            uint64_t rows[64];
+            for (int i = 0; i < 64; ++i) {
+                const DesLaneKey& key = keys[64 * g + i];
+                rows[i] = (key.schedule->key_bits << 8) | (key.decrypt ? 0xFF : 0);
+            }
+            transpose64(rows);
+            for (int j = 0; j < 57; ++j) {
+                words[j * groups + g] = rows[j];
+            }
+        }
+        std::memcpy(slices, words, sizeof(slices));
+    }
+
+    DES_BITSLICE_INLINE void start_round(int round) {
+        const uint8_t* encrypt_sources = ROUND_KEY_SOURCES[round].data();
+        const uint8_t* decrypt_sources = ROUND_KEY_SOURCES[15 - round].data();
+        for (int k = 0; k < 48; ++k) {
+            const Lane& encrypt_bit = slices[encrypt_sources[k]];
+            current[k] = encrypt_bit ^ ((encrypt_bit ^ slices[decrypt_sources[k]]) & slices[56]);
+        }
+    }
+
+    DES_BITSLICE_INLINE void mix(int index, const Lane& data, Lane& x) const { x = data ^ current[index]; }
+};
+
+// One S-box of one round: expand, mix in the key, substitute and XOR the
+// permuted output into the left half
+template <typename Lane, int Box, typename Keys>
+DES_BITSLICE_INLINE void bitslice_s_box(const Lane* right, Lane* left, const Keys& keys) {
+    Lane x[6];
+    for (int k = 0; k < 6; ++k) {
+        keys.mix(6 * Box + k, right[E_TABLE[6 * Box + k] - 1], x[k]);
+    }
+    bitslice_s_box_bit<Lane, Box, 0>(x, left);
+    bitslice_s_box_bit<Lane, Box, 1>(x, left);
+    bitslice_s_box_bit<Lane, Box, 2>(x, left);
+    bitslice_s_box_bit<Lane, Box, 3>(x, left);
+}
+
+// Runs DES over 64 * (sizeof(Lane) / 8) blocks with the round keys from keys
+template <typename Lane, typename Keys>
+DES_BITSLICE_INLINE void bitslice_pass(const uint64_t* in, uint64_t* out, Keys& keys) {
+    constexpr size_t groups = sizeof(Lane) / sizeof(uint64_t);
+
+    // Transpose each group of 64 blocks; word g of slice b covers blocks 64g..64g+63
+    alignas(64) uint64_t words[64 * groups];
+    for (size_t g = 0; g < groups; ++g) {
+        uint64_t rows[64];
+        std::copy(in + 64 * g, in + 64 * g + 64, rows);
+        transpose64(rows);
+        for (int b = 0; b < 64; ++b) {
+            words[b * groups + g] = rows[b];
+        }
+    }
+    Lane slices[64];
+    std::memcpy(slices, words, sizeof(slices));
+
+    // Initial Permutation (IP) is a renaming of slices
+    Lane halves[2][32];
+    for (int i = 0; i < 32; ++i) {
+        halves[0][i] = slices[IP_TABLE[i] - 1];
+        halves[1][i] = slices[IP_TABLE[32 + i] - 1];
+    }
+
+    // 16 Feistel rounds; the left half becomes the new right half in place, then roles swap
+    Lane* left = halves[0];
+    Lane* right = halves[1];
+    for (int r = 0; r < 16; ++r) {
+        keys.start_round(r);
+        bitslice_s_box<Lane, 0>(right, left, keys);
+        bitslice_s_box<Lane, 1>(right, left, keys);
+        bitslice_s_box<Lane, 2>(right, left, keys);
+        bitslice_s_box<Lane, 3>(right, left, keys);
+        bitslice_s_box<Lane, 4>(right, left, keys);
+        bitslice_s_box<Lane, 5>(right, left, keys);
+        bitslice_s_box<Lane, 6>(right, left, keys);
+        bitslice_s_box<Lane, 7>(right, left, keys);
+        std::swap(left, right);
+    }
+
+    // Swap halves back (R16 L16) and apply Inverse Initial Permutation (IP_INV)
+    for (int i = 0; i < 64; ++i) {
+        int source = IP_INV_TABLE[i] - 1;
+        slices[i] = source < 32 ? right[source] : left[source - 32];
+    }
+
+    std::memcpy(words, slices, sizeof(slices));
+    for (size_t g = 0; g < groups; ++g) {
+        uint64_t rows[64];
+        for (int b = 0; b < 64; ++b) {
+            rows[b] = words[b * groups + g];
+        }
+        transpose64(rows);
+        std::copy(rows, rows + 64, out + 64 * g);
+    }
+}
+
+template <typename Lane>
+DES_BITSLICE_INLINE void shared_key_pass(const uint64_t* in, uint64_t* out, const uint64_t round_keys[16]) {
+    SharedRoundKeys<Lane> keys{round_keys};
+    bitslice_pass<Lane>(in, out, keys);
+}
+
+template <typename Lane>
+DES_BITSLICE_INLINE void keyed_pass(const uint64_t* in, uint64_t* out, const DesLaneKey* lane_keys) {
+    LaneRoundKeys<Lane> keys(lane_keys);
+    bitslice_pass<Lane>(in, out, keys);
+}
+
+void bitslice_pass_64(const uint64_t* in, uint64_t* out, const uint64_t round_keys[16]) {
+    shared_key_pass<uint64_t>(in, out, round_keys);
+}
+
+void bitslice_pass_128(const uint64_t* in, uint64_t* out, const uint64_t round_keys[16]) {
+    shared_key_pass<Slice128>(in, out, round_keys);
+}
+
+void bitslice_keyed_pass_64(const uint64_t* in, uint64_t* out, const DesLaneKey* keys) {
+    keyed_pass<uint64_t>(in, out, keys);
+}
+
+void bitslice_keyed_pass_128(const uint64_t* in, uint64_t* out, const DesLaneKey* keys) {
+    keyed_pass<Slice128>(in, out, keys);
+}
+
+#if DES_HAVE_X86_DISPATCH
+__attribute__((target("avx2")))
+void bitslice_pass_256(const uint64_t* in, uint64_t* out, const uint64_t round_keys[16]) {
+    shared_key_pass<Slice256>(in, out, round_keys);
+}
+
+__attribute__((target("avx512f")))
+void bitslice_pass_512(const uint64_t* in, uint64_t* out, const uint64_t round_keys[16]) {
+    shared_key_pass<Slice512>(in, out, round_keys);
+}
+
+__attribute__((target("avx2")))
+void bitslice_keyed_pass_256(const uint64_t* in, uint64_t* out, const DesLaneKey* keys) {
+    keyed_pass<Slice256>(in, out, keys);
+}
+
+__attribute__((target("avx512f")))
+void bitslice_keyed_pass_512(const uint64_t* in, uint64_t* out, const DesLaneKey* keys) {
+    keyed_pass<Slice512>(in, out, keys);
+}
+#endif
+
+#endif // DES_HAVE_BITSLICE
+
+// --- Engine Dispatch ---
+
+const DesEngineInfo* find_engine(DesEngine engine) {
+    static const DesEngineInfo engines[] = {
+        {DesEngine::Scalar, "scalar", 0, nullptr, nullptr},
+#if DES_HAVE_BITSLICE
+        {DesEngine::Bitslice64, "bitslice64", 64, bitslice_pass_64, bitslice_keyed_pass_64},
+        {DesEngine::Bitslice128, "bitslice128", 128, bitslice_pass_128, bitslice_keyed_pass_128},
+#if DES_HAVE_X86_DISPATCH
+        {DesEngine::Bitslice256, "bitslice256-avx2", 256, bitslice_pass_256, bitslice_keyed_pass_256},
+        {DesEngine::Bitslice512, "bitslice512-avx512", 512, bitslice_pass_512, bitslice_keyed_pass_512},
+#endif
+#endif
+    };
+    for (const DesEngineInfo& info : engines) {
+        if (info.engine == engine) return &info;
+    }
+    return nullptr;
+}
+
+// Whether the CPU can run an engine
+bool engine_supported(DesEngine engine) {
+    if (find_engine(engine) == nullptr) return false;
+#if DES_HAVE_X86_DISPATCH
+    if (engine == DesEngine::Bitslice256) return __builtin_cpu_supports("avx2");
+    if (engine == DesEngine::Bitslice512) return __builtin_cpu_supports("avx512f");
+#endif
+    return true;
+}
+
+// Known-answer check of a bit-sliced engine against the scalar path
+bool engine_matches_scalar(const DesEngineInfo& info) {
+    if (info.pass == nullptr) return true;
+    const DesKeySchedule schedule(0x133457799BBCDFF1ull);
+    std::vector<uint64_t> blocks(info.blocks_per_pass), output(info.blocks_per_pass);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i] = 0x0123456789ABCDEFull * (2 * i + 1) ^ (i << 17);
+    }
+    info.pass(blocks.data(), output.data(), schedule.encrypt_keys);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (output[i] != des_process_block(blocks[i], schedule.encrypt_keys)) return false;
+    }
+
+    // Keyed pass: alternate two keys and both directions across the blocks
+    const DesKeySchedule other(0x0E329232EA6D0D73ull);
+    std::vector<DesLaneKey> keys(info.blocks_per_pass);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        keys[i] = {i % 3 == 0 ? &other : &schedule, i % 2 == 1};
+    }
+    info.keyed_pass(blocks.data(), output.data(), keys.data());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (output[i] != des_process_block(blocks[i], keys[i].round_keys())) return false;
+    }
+    return true;
+}
+
+// Widest supported engine that passes the known-answer check
+const DesEngineInfo* detect_engine() {
+    const DesEngine preferred[] = {DesEngine::Bitslice512, DesEngine::Bitslice256,
+                                   DesEngine::Bitslice128, DesEngine::Bitslice64};
+    for (DesEngine engine : preferred) {
+        if (engine_supported(engine) && engine_matches_scalar(*find_engine(engine))) {
+            return find_engine(engine);
+        }
+    }
+    return find_engine(DesEngine::Scalar);
+}
+
+std::atomic<const DesEngineInfo*> active_engine{nullptr};
+
+} // namespace
+
+const DesEngineInfo& des_engine_info() {
+    const DesEngineInfo* info = active_engine.load(std::memory_order_acquire);
+    if (info == nullptr) {
+        info = detect_engine();
+        active_engine.store(info, std::memory_order_release);
+    }
+    return *info;
+}
+
+bool des_set_engine(DesEngine engine) {
+    if (!engine_supported(engine)) return false;
+    active_engine.store(find_engine(engine), std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,119 @@
+// Thread registry behind metrics.hpp: each thread's slot block is listed
+// while the thread runs and folded into a retired total when it exits.
+
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include "metrics.hpp"
+
+namespace {
+
+constexpr const char* METRIC_NAMES[METRIC_COUNT] = {
+    "des_key_schedules", "des_blocks", "ecb_blocks", "cbc_blocks", "ctr_blocks",
+    "mode_bytes", "mod_exp_calls", "mod_exp_squarings", "mod_exp_multiplies",
+};
+
+constexpr const char* TIMER_NAMES[TIMER_COUNT] = {"key_schedule", "des_blocks", "mod_exp"};
+
+struct Registry {
+    std::mutex lock;
+    std::vector<std::pair<std::thread::id, MetricsSlots*>> live;
+    MetricsSnapshot retired;
+};
+
+// Never destroyed, so threads that exit during static destruction still fold in
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+void accumulate(MetricsSnapshot& total, const MetricsSlots& slots) {
+    for (size_t i = 0; i < METRIC_COUNT; ++i) total.counters[i] += slots.counters[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+        total.timer_calls[i] += slots.timer_calls[i].load(std::memory_order_relaxed);
+        total.timer_nanoseconds[i] += slots.timer_nanoseconds[i].load(std::memory_order_relaxed);
+    }
+}
+
+void clear(MetricsSlots& slots) {
+    for (auto& counter : slots.counters) counter.store(0, std::memory_order_relaxed);
+    for (auto& calls : slots.timer_calls) calls.store(0, std::memory_order_relaxed);
+    for (auto& nanoseconds : slots.timer_nanoseconds) nanoseconds.store(0, std::memory_order_relaxed);
+}
+
+// Takes the counts of a thread whose registration is already destroyed (from
+// other thread_local destructors running later at thread exit). Never read,
+// and never destroyed.
+MetricsSlots& exited_thread_sink() {
+    static MetricsSlots* sink = new MetricsSlots();
+    return *sink;
+}
+
+// Trivially destructible, so it stays readable after the registration is gone
+thread_local bool registration_destroyed = false;
+
+struct ThreadRegistration {
+    MetricsSlots slots;
+
+    ThreadRegistration() {
+        clear(slots);
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.live.emplace_back(std::this_thread::get_id(), &slots);
+    }
+
+    ~ThreadRegistration() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        accumulate(r.retired, slots);
+        r.live.erase(std::find_if(r.live.begin(), r.live.end(),
+                                  [this](const auto& entry) { return entry.second == &slots; }));
+        registration_destroyed = true;
+        metrics_local_slots = &exited_thread_sink();
+    }
+};
+
+} // namespace
+
+const char* metric_name(Metric metric) {
+    return METRIC_NAMES[static_cast<size_t>(metric)];
+}
+
+const char* timer_name(Timer timer) {
+    return TIMER_NAMES[static_cast<size_t>(timer)];
+}
+
+MetricsSlots& metrics_register_thread() {
+    if (registration_destroyed) return exited_thread_sink();
+    thread_local ThreadRegistration registration;
+    metrics_local_slots = &registration.slots;
+    return registration.slots;
+}
+
+MetricsSnapshot metrics_snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    MetricsSnapshot total = r.retired;
+    for (const auto& entry : r.live) accumulate(total, *entry.second);
+    return total;
+}
+
+std::vector<ThreadMetrics> metrics_per_thread() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    std::vector<ThreadMetrics> threads;
+    threads.reserve(r.live.size());
+    for (const auto& entry : r.live) {
+        ThreadMetrics thread{entry.first, {}};
+        accumulate(thread.metrics, *entry.second);
+        threads.push_back(thread);
+    }
+    return threads;
+}
+
+void metrics_reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.retired = MetricsSnapshot();
+    for (const auto& entry : r.live) clear(*entry.second);
+}
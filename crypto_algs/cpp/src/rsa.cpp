@@ -0,0 +1,156 @@
+// Out-of-line parts of rsa.hpp: long division, the CPU check for the IFMA
+// batch path, the OS random source, the sieve primes and the standard-size
+// instantiations.
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <random>
+#include <cerrno>
+#include "rsa.hpp"
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+// --- Limb Arithmetic ---
+
+void divmod_limbs(const uint64_t* u, size_t m, const uint64_t* v, size_t n,
+                  uint64_t* q, uint64_t* r, LimbArena& arena) {
+    size_t n_out = n;
+    size_t q_out = m >= n ? m - n + 1 : 0;
+    n = significant_limbs(v, n);
+    if (n == 0) throw std::domain_error("division by zero");
+    m = significant_limbs(u, m);
+    for (size_t i = 0; q && i < q_out; ++i) q[i] = 0;
+    for (size_t i = 0; r && i < n_out; ++i) r[i] = 0;
+
+    if (m < n) {
+        for (size_t i = 0; r && i < m; ++i) r[i] = u[i];
+        return;
+    }
+
+    if (n == 1) {
+        // Short division by a single limb
+        uint64_t remainder = 0;
+        for (size_t i = m; i-- > 0;) {
+            uint128_t numerator = (static_cast<uint128_t>(remainder) << 64) | u[i];
+            if (q) q[i] = static_cast<uint64_t>(numerator / v[0]);
+            remainder = static_cast<uint64_t>(numerator % v[0]);
+        }
+        if (r) r[0] = remainder;
+        return;
+    }
+
+    ArenaScope scope(arena);
+    uint64_t* vn = arena.allocate(n);
+    uint64_t* un = arena.allocate(m + 1);
+
+    // D1. Normalize so the top limb of v has its high bit set
+    int shift = __builtin_clzll(v[n - 1]);
+    for (size_t i = n - 1; i > 0; --i) {
+        vn[i] = (v[i] << shift) | (shift ? v[i - 1] >> (64 - shift) : 0);
+    }
+    vn[0] = v[0] << shift;
+    un[m] = shift ? u[m - 1] >> (64 - shift) : 0;
+    for (size_t i = m - 1; i > 0; --i) {
+        un[i] = (u[i] << shift) | (shift ? u[i - 1] >> (64 - shift) : 0);
+    }
+    un[0] = u[0] << shift;
+
+    for (size_t j = m - n + 1; j-- > 0;) {
+        // D3. Estimate the quotient limb from the top two limbs
+        uint128_t numerator = (static_cast<uint128_t>(un[j + n]) << 64) | un[j + n - 1];
+        uint128_t qhat = numerator / vn[n - 1];
+        uint128_t rhat = numerator % vn[n - 1];
+        while ((qhat >> 64) != 0 ||
+               qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if ((rhat >> 64) != 0) break;
+        }
+
+        // D4. Multiply and subtract
+        uint64_t mul_carry = 0;
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint128_t product = qhat * vn[i] + mul_carry;
+            mul_carry = static_cast<uint64_t>(product >> 64);
+            uint64_t low = static_cast<uint64_t>(product);
+            uint64_t diff = un[i + j] - low;
+            uint64_t next_borrow = (un[i + j] < low) | (diff < borrow);
+            un[i + j] = diff - borrow;
+            borrow = next_borrow;
+        }
+        uint128_t top_sub = static_cast<uint128_t>(mul_carry) + borrow;
+        bool negative = top_sub > un[j + n];
+        un[j + n] -= static_cast<uint64_t>(top_sub);
+
+        // D6. Add back when the estimate was one too large
+        if (negative) {
+            --qhat;
+            un[j + n] += add_limbs(un + j, un + j, vn, n);
+        }
+        if (q) q[j] = static_cast<uint64_t>(qhat);
+    }
+
+    // D8. Unnormalize the remainder
+    if (r) {
+        for (size_t i = 0; i < n; ++i) {
+            r[i] = (un[i] >> shift) | (shift ? un[i + 1] << (64 - shift) : 0);
+        }
+    }
+}
+
+// --- Batch Exponentiation ---
+
+#if RSA_HAVE_IFMA
+bool cpu_has_ifma() {
+    static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+    return supported;
+}
+#endif
+
+// --- Key Generation ---
+
+void secure_random_fill(uint8_t* bytes, size_t length) {
+#if defined(__linux__)
+    while (length > 0) {
+        ssize_t got = getrandom(bytes, length, 0);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOSYS) break; // kernel before 3.17: use std::random_device
+            throw std::runtime_error("getrandom failed");
+        }
+        bytes += got;
+        length -= static_cast<size_t>(got);
+    }
+#endif
+    if (length == 0) return;
+    thread_local std::random_device device;
+    for (size_t i = 0; i < length; i += 4) {
+        uint32_t word = device();
+        for (size_t j = 0; j < 4 && i + j < length; ++j) bytes[i + j] = static_cast<uint8_t>(word >> (8 * j));
+    }
+}
+
+const std::vector<uint32_t>& small_primes() {
+    static const std::vector<uint32_t> primes = [] {
+        std::vector<bool> composite(SIEVE_LIMIT + 1, false);
+        std::vector<uint32_t> found;
+        for (uint32_t num = 3; num <= SIEVE_LIMIT; num += 2) {
+            if (composite[num]) continue;
+            found.push_back(num);
+            for (uint32_t multiple = num * num; multiple <= SIEVE_LIMIT; multiple += 2 * num) {
+                composite[multiple] = true;
+            }
+        }
+        return found;
+    }();
+    return primes;
+}
+
+// --- Standard Sizes ---
+
+RSA_STANDARD_TEMPLATES()
@@ -0,0 +1,427 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "des.hpp"
+#include "rsa.hpp" // secure_random_fill
+
+// --- DES File Encryption ---
+// Encrypts or decrypts a file of any size with DES or Triple DES in CBC or
+// CTR mode, in the layout of crypto_manager.py: the 8-byte IV (CBC) or
+// nonce (CTR) comes first, then the ciphertext; CBC is PKCS#7 padded and CTR
+// is not padded. An 8-byte key runs single DES, 16 bytes two-key 3DES
+// (K3 = K1) and 24 bytes three-key 3DES, as the `cryptography` TripleDES
+// cipher treats them.
+//
+// The input is memory-mapped (or read in chunks from a pipe) and processed
+// CHUNK_SIZE bytes at a time into two alternating output buffers. A writer
+// thread writes one buffer while the next chunk is encrypted into the other,
+// and CTR and CBC decryption also spread each chunk over --threads workers.
+//
+// Counter layouts:
+//   counter  the whole counter block is one big-endian integer, +1 per block
+//            (des_encrypt_blocks Mode::CTR)
+//   python   crypto_manager.py's fallback CTR for TripleDES (ctr_offset_bytes):
+//            the last two nonce bytes plus the byte offset of the block.
+//            Python cannot go past 16 bits there, so these files stay under
+//            64 KiB.
+// CBC IVs and CTR nonces come from the OS CSPRNG (secure_random_fill), as
+// crypto_manager.py draws them from os.urandom.
+
+constexpr size_t CHUNK_SIZE = 4 << 20; // a multiple of the parallel chunk size
+constexpr size_t HEADER_SIZE = 8;
+
+const char* USAGE =
+    "usage: descrypt encrypt|decrypt --mode=cbc|ctr (--key=HEX | --key-file=PATH)\n"
+    "                [--ctr=counter|python] [--threads=N] INPUT OUTPUT\n"
+    "  The key is 8, 16 or 24 bytes (DES, two-key or three-key 3DES); a key file\n"
+    "  holds the raw bytes. INPUT or OUTPUT may be - for stdin or stdout.\n";
+
+struct CryptOptions {
+    bool decrypt = false;
+    Mode mode = Mode::CBC;
+    bool python_ctr = false;
+    std::vector<uint8_t> key;
+    unsigned threads = 0;
+    std::string input;
+    std::string output;
+};
+
+// Function to build an error message from errno
+std::runtime_error os_error(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// --- Input ---
+
+// Hands out the input in fixed-size pieces: a regular file is mapped and read
+// in place, anything else (a pipe, stdin) is read into a buffer
+class InputFile {
+public:
+    explicit InputFile(const std::string& path) {
+        fd_ = path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) throw os_error("cannot open " + path);
+        struct stat info;
+        if (::fstat(fd_, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            size_ = static_cast<size_t>(info.st_size);
+            void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (map != MAP_FAILED) {
+                map_ = static_cast<const uint8_t*>(map);
+                ::madvise(map, size_, MADV_SEQUENTIAL);
+            }
+        }
+    }
+
+    ~InputFile() {
+        if (map_ != nullptr) ::munmap(const_cast<uint8_t*>(map_), size_);
+        if (fd_ != STDIN_FILENO) ::close(fd_);
+    }
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    int fd() const { return fd_; }
+
+    // Function to point data at the next length bytes; returns fewer only at
+    // the end of the input
+    size_t next(size_t length, const uint8_t*& data) {
+        if (map_ != nullptr) {
+            size_t take = std::min(length, size_ - offset_);
+            data = map_ + offset_;
+            offset_ += take;
+            return take;
+        }
+        buffer_.resize(length);
+        size_t filled = 0;
+        while (filled < length) {
+            ssize_t got = ::read(fd_, buffer_.data() + filled, length - filled);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) throw os_error("read failed");
+            if (got == 0) break;
+            filled += static_cast<size_t>(got);
+        }
+        data = buffer_.data();
+        return filled;
+    }
+
+private:
+    int fd_;
+    const uint8_t* map_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    std::vector<uint8_t> buffer_;
+};
+
+// --- Output ---
+
+// Writes one buffer on a background thread while the caller fills the next.
+// submit() waits for the previous write, so with two buffers used in turn a
+// buffer is never refilled while it is still being written.
+class PipelinedWriter {
+public:
+    explicit PipelinedWriter(int fd) : fd_(fd), thread_([this] { run(); }) {}
+
+    ~PipelinedWriter() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            closing_ = true;
+        }
+        ready_.notify_all();
+        thread_.join();
+    }
+
+    PipelinedWriter(const PipelinedWriter&) = delete;
+    PipelinedWriter& operator=(const PipelinedWriter&) = delete;
+
+    void submit(const uint8_t* data, size_t length) {
+        std::unique_lock<std::mutex> guard(lock_);
+        done_.wait(guard, [this] { return pending_ == nullptr; });
+        if (!error_.empty()) throw std::runtime_error(error_);
+        pending_ = data;
+        pending_length_ = length;
+        ready_.notify_all();
+    }
+
+    // Function to wait for the last write; throws if any write failed
+    void finish() {
+        std::unique_lock<std::mutex> guard(lock_);
+        done_.wait(guard, [this] { return pending_ == nullptr; });
+        if (!error_.empty()) throw std::runtime_error(error_);
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> guard(lock_);
+        for (;;) {
+            ready_.wait(guard, [this] { return pending_ != nullptr || closing_; });
+            if (pending_ == nullptr) return;
+            const uint8_t* data = pending_;
+            size_t length = pending_length_;
+            guard.unlock();
+            std::string error = write_all(data, length);
+            guard.lock();
+            if (error_.empty()) error_ = error;
+            pending_ = nullptr;
+            done_.notify_all();
+        }
+    }
+
+    std::string write_all(const uint8_t* data, size_t length) {
+        while (length > 0) {
+            ssize_t written = ::write(fd_, data, length);
+            if (written < 0 && errno == EINTR) continue;
+            if (written < 0) return std::string("write failed: ") + std::strerror(errno);
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return "";
+    }
+
+    int fd_;
+    std::mutex lock_;
+    std::condition_variable ready_;
+    std::condition_variable done_;
+    const uint8_t* pending_ = nullptr;
+    size_t pending_length_ = 0;
+    bool closing_ = false;
+    std::string error_;
+    std::thread thread_;
+};
+
+// --- Cipher Dispatch ---
+// The same stream code runs over a DES or a 3DES key schedule
+
+inline void encrypt_blocks(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    des_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void encrypt_blocks(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                           Mode mode, uint8_t* iv) {
+    tdes_encrypt_blocks(in, out, nblocks, schedule, mode, iv);
+}
+
+inline void ctr_parallel(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                         uint8_t* counter, unsigned threads) {
+    des_ctr_parallel(in, out, nblocks, schedule, counter, threads);
+}
+
+inline void ctr_parallel(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                         uint8_t* counter, unsigned threads) {
+    tdes_ctr_parallel(in, out, nblocks, schedule, counter, threads);
+}
+
+inline void cbc_decrypt_parallel(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t nblocks,
+                                 uint8_t* iv, unsigned threads) {
+    des_cbc_decrypt_parallel(in, out, nblocks, schedule, iv, threads);
+}
+
+inline void cbc_decrypt_parallel(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out,
+                                 size_t nblocks, uint8_t* iv, unsigned threads) {
+    tdes_cbc_decrypt_parallel(in, out, nblocks, schedule, iv, threads);
+}
+
+inline void ctr_offset(const DesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t length,
+                       const uint8_t* nonce, uint64_t offset) {
+    des_ctr_offset(in, out, length, schedule, nonce, offset);
+}
+
+inline void ctr_offset(const TripleDesKeySchedule& schedule, const uint8_t* in, uint8_t* out, size_t length,
+                       const uint8_t* nonce, uint64_t offset) {
+    tdes_ctr_offset(in, out, length, schedule, nonce, offset);
+}
+
+// --- Stream Processing ---
+
+template <typename Schedule>
+void crypt_stream(const Schedule& schedule, const CryptOptions& options, InputFile& input, int output_fd) {
+    // Room for a carried prefix (the header or a held-back block) and the padding block
+    std::vector<uint8_t> buffers[2] = {std::vector<uint8_t>(CHUNK_SIZE + 2 * HEADER_SIZE),
+                                       std::vector<uint8_t>(CHUNK_SIZE + 2 * HEADER_SIZE)};
+    uint8_t iv[HEADER_SIZE];
+    uint8_t nonce[HEADER_SIZE];
+    uint8_t carry[HEADER_SIZE];
+    size_t carry_length = 0;
+
+    if (options.decrypt) {
+        const uint8_t* header;
+        if (input.next(HEADER_SIZE, header) != HEADER_SIZE) throw std::runtime_error("input is missing the IV header");
+        std::memcpy(iv, header, HEADER_SIZE);
+    } else {
+        secure_random_fill(iv, HEADER_SIZE);
+        std::memcpy(carry, iv, HEADER_SIZE);
+        carry_length = HEADER_SIZE;
+    }
+    std::memcpy(nonce, iv, HEADER_SIZE);
+
+    PipelinedWriter writer(output_fd);
+    uint64_t offset = 0; // bytes of payload processed so far
+    for (int turn = 0;; turn ^= 1) {
+        const uint8_t* data;
+        size_t length = input.next(CHUNK_SIZE, data);
+        bool last = length < CHUNK_SIZE;
+        uint8_t* out = buffers[turn].data();
+        std::memcpy(out, carry, carry_length);
+        uint8_t* body = out + carry_length;
+        size_t out_length = carry_length + length;
+        carry_length = 0;
+        size_t whole = length / 8;
+
+        if (options.mode == Mode::CTR && options.python_ctr) {
+            ctr_offset(schedule, data, body, length, nonce, offset);
+        } else if (options.mode == Mode::CTR) {
+            ctr_parallel(schedule, data, body, whole, iv, options.threads);
+            if (length % 8 != 0) {
+                uint8_t block[8] = {};
+                encrypt_blocks(schedule, block, block, 1, Mode::CTR, iv);
+                for (size_t b = 0; b < length % 8; ++b) body[8 * whole + b] = data[8 * whole + b] ^ block[b];
+            }
+        } else if (!options.decrypt) {
+            encrypt_blocks(schedule, data, body, whole, Mode::CBC, iv);
+            if (last) {
+                uint8_t block[8];
+                std::memcpy(block, data + 8 * whole, length % 8);
+                pkcs7_pad(block, length % 8);
+                encrypt_blocks(schedule, block, body + 8 * whole, 1, Mode::CBC, iv);
+                out_length += 8 - length % 8;
+            }
+        } else {
+            if (last && length % 8 != 0) throw std::runtime_error("ciphertext is not a whole number of blocks");
+            cbc_decrypt_parallel(schedule, data, body, whole, iv, options.threads);
+            // The last plaintext block carries the padding: hold it back
+            // until the end of the input is known
+            if (out_length < 8) throw std::runtime_error("ciphertext is empty");
+            if (last) {
+                size_t tail;
+                if (!pkcs7_unpad(out + out_length - 8, 8, tail)) {
+                    throw std::runtime_error("bad padding (wrong key or corrupt input)");
+                }
+                out_length -= 8 - tail;
+            } else {
+                out_length -= 8;
+                std::memcpy(carry, out + out_length, 8);
+                carry_length = 8;
+            }
+        }
+
+        offset += length;
+        writer.submit(out, out_length);
+        if (last) break;
+    }
+    writer.finish();
+}
+
+// --- Command Line ---
+
+std::vector<uint8_t> parse_hex_bytes(const std::string& hex) {
+    if (hex.size() % 2 != 0) throw std::invalid_argument("key hex must have an even number of digits");
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        uint8_t high = HEX_VALUES[static_cast<uint8_t>(hex[2 * i])];
+        uint8_t low = HEX_VALUES[static_cast<uint8_t>(hex[2 * i + 1])];
+        if (high == 0xFF || low == 0xFF) throw std::invalid_argument("key is not valid hex");
+        bytes[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> read_key_file(const std::string& path) {
+    InputFile file(path);
+    const uint8_t* data;
+    size_t length = file.next(32, data);
+    return std::vector<uint8_t>(data, data + length);
+}
+
+CryptOptions parse_options(int argc, char** argv) {
+    CryptOptions options;
+    std::vector<std::string> positional;
+    bool have_mode = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string flag = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (arg == "-" || arg[0] != '-') positional.push_back(arg);
+        else if (flag == "--mode" && (value == "cbc" || value == "ctr")) {
+            options.mode = value == "cbc" ? Mode::CBC : Mode::CTR;
+            have_mode = true;
+        }
+        else if (flag == "--key") options.key = parse_hex_bytes(value);
+        else if (flag == "--key-file") options.key = read_key_file(value);
+        else if (flag == "--ctr" && (value == "counter" || value == "python")) options.python_ctr = value == "python";
+        else if (flag == "--threads") options.threads = static_cast<unsigned>(std::stoul(value));
+        else throw std::invalid_argument("unknown option: " + arg);
+    }
+    if (positional.size() != 3 || (positional[0] != "encrypt" && positional[0] != "decrypt")) {
+        throw std::invalid_argument("expected encrypt|decrypt INPUT OUTPUT");
+    }
+    if (!have_mode) throw std::invalid_argument("--mode is required");
+    if (options.key.size() != 8 && options.key.size() != 16 && options.key.size() != 24) {
+        throw std::invalid_argument("key must be 8, 16 or 24 bytes");
+    }
+    if (options.python_ctr && options.mode != Mode::CTR) throw std::invalid_argument("--ctr only applies to CTR");
+    options.decrypt = positional[0] == "decrypt";
+    options.input = positional[1];
+    options.output = positional[2];
+    return options;
+}
+
+int main(int argc, char** argv) {
+    CryptOptions options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << "descrypt: " << error.what() << "\n" << USAGE;
+        return 2;
+    }
+
+    // A failed run removes the partial output file, unless it is the input
+    bool to_stdout = options.output == "-";
+    bool remove_on_error = false;
+    int output_fd = -1;
+    try {
+        InputFile input(options.input);
+        // Truncate only after checking the output is not the (mapped) input
+        output_fd = to_stdout ? STDOUT_FILENO : ::open(options.output.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (output_fd < 0) throw os_error("cannot open " + options.output);
+        struct stat in_info, out_info;
+        if (!to_stdout && ::fstat(input.fd(), &in_info) == 0 && ::fstat(output_fd, &out_info) == 0 &&
+            in_info.st_dev == out_info.st_dev && in_info.st_ino == out_info.st_ino) {
+            throw std::runtime_error("input and output are the same file");
+        }
+        remove_on_error = !to_stdout;
+        if (remove_on_error && ::ftruncate(output_fd, 0) != 0) throw os_error("cannot truncate " + options.output);
+
+        const std::vector<uint8_t>& key = options.key;
+        if (key.size() == 8) {
+            crypt_stream(DesKeySchedule(load_be64(key.data())), options, input, output_fd);
+        } else {
+            crypt_stream(TripleDesKeySchedule(load_be64(key.data()), load_be64(key.data() + 8),
+                                              load_be64(key.data() + (key.size() == 24 ? 16 : 0))),
+                         options, input, output_fd);
+        }
+        if (!to_stdout) {
+            int result = ::close(output_fd);
+            output_fd = -1;
+            if (result != 0) throw os_error("cannot close " + options.output);
+        }
+    } catch (const std::exception& error) {
+        std::cerr << "descrypt: " << error.what() << "\n";
+        if (!to_stdout && output_fd >= 0) ::close(output_fd);
+        if (remove_on_error) ::unlink(options.output.c_str());
+        return 1;
+    }
+    return 0;
+}
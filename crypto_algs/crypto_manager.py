@@ -7,10 +7,11 @@ from cryptography.hazmat.primitives import hashes
 from cryptography.hazmat.backends import default_backend
 from typing import Literal, Optional
 
+# Native DES cores (cpp/python/native_module.cpp) via utils, used when built
 try:
-    from .utils import xor_bytes
+    from .utils import xor_bytes, _native
 except ImportError:
-    from utils import xor_bytes
+    from utils import xor_bytes, _native
 class CryptoManager:
     """
     A manager for performing encryption and decryption using various algorithms
@@ -122,20 +123,19 @@ class CryptoManager:
         response_text = iv_or_nonce if encdec == 'encrypt' else b''#.to_bytes(1, byteorder='big')
         # print(response_text)
         if 'CTR' in str(type(mode)):
-            # assert(len(padded_data) % len(iv_or_nonce) == 0), "CTR mode requires data length to be a multiple of nonce length."
+            # The counter for the block at byte offset i is the nonce with its
+            # last two bytes replaced by (those bytes + i)
+            if _native is not None and self.algorithm_name == 'TripleDES':
+                return response_text + _native.des_ctr_offset(self.key, iv_or_nonce, padded_data)
+            counter_blocks = []
             for i in range(0, len(padded_data), len(iv_or_nonce)):
                 integer_last_byte = int.from_bytes(iv_or_nonce[-2:], byteorder='big') + i
                 last_2bytes = integer_last_byte.to_bytes(2, byteorder='big')
-                iv_bytes = iv_or_nonce[:-2] + last_2bytes
-                block = padded_data[i:i + len(iv_bytes)]
-                # if encdec == 'encrypt':
-                encryptor = cipher.encryptor()
-                encrypted_iv = encryptor.update(iv_bytes) + encryptor.finalize()
-                # elif encdec == 'decrypt':
-                #     decryptor = cipher.decryptor()
-                #     response_text += decryptor.update(ctr_block) + decryptor.finalize()
-                ctr_block = xor_bytes(block, encrypted_iv[0:len(block)])
-                response_text += ctr_block
+                counter_blocks.append(iv_or_nonce[:-2] + last_2bytes)
+            # One ECB pass over all counter blocks gives the whole keystream
+            encryptor = cipher.encryptor()
+            keystream = encryptor.update(b''.join(counter_blocks)) + encryptor.finalize()
+            response_text += xor_bytes(padded_data, keystream[:len(padded_data)])
 
         return response_text
 
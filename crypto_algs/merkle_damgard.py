@@ -4,6 +4,12 @@ A demonstration implementation of the Merkle-Damgård construction
 using a simple compression function.
 """
 
+# Native core (cpp/merkle_damgard.hpp) for the default block and output sizes
+try:
+    from .utils import _native
+except ImportError:
+    from utils import _native
+
 class MerkleDamgardHash:
     """
     A hash function implementing the Merkle-Damgård construction.
@@ -122,6 +128,10 @@ class MerkleDamgardHash:
             blocks.append(padded_message[i:i + self.block_size])
         return blocks
     
+    def _use_native(self):
+        """The C++ core only implements the default 64-byte block, 32-byte output."""
+        return _native is not None and self.block_size == 64 and self.output_size == 32
+    
     def hash(self, message):
         """
         Compute hash of message using Merkle-Damgård construction.
@@ -135,6 +145,8 @@ class MerkleDamgardHash:
         # Convert string to bytes if necessary
         if isinstance(message, str):
             message = message.encode('utf-8')
+        if self._use_native():
+            return _native.merkle_damgard(message).hex()
         
         # Step 1: Pad the message
         padded = self._pad_message(message)
@@ -162,6 +174,8 @@ class MerkleDamgardHash:
         """
         if isinstance(message, str):
             message = message.encode('utf-8')
+        if self._use_native():
+            return _native.merkle_damgard(message)
         
         padded = self._pad_message(message)
         blocks = self._split_into_blocks(padded)
@@ -4,8 +4,10 @@ import random
 
 try:
     from .rotate_string import rotate_string_left, split_and_swap_bytearray, mirror_swap_bytearray
+    from .utils import xor_bytes
 except ImportError:
     from rotate_string import rotate_string_left, split_and_swap_bytearray, mirror_swap_bytearray
+    from utils import xor_bytes
 
 def shuffle_bits_in_byte(byte_val, permutation):
     if permutation is None:
@@ -59,12 +61,6 @@ def decrypt(ciphertext, key):
     # If it was made even, remove last character _
     return plaintext #[:-1] if plaintext[-1] == ord('_') else plaintext
         
-def xor_bytes(byte_str1, byte_str2):
-     byte_str1, byte_str2 = bytes(byte_str1), bytes(byte_str2)
-     # Simplest concept of DES
-     # Requires both strings to be the same length
-     return bytes(a ^ b for a, b in zip(byte_str1, byte_str2))
-
 if __name__ == "__main__":
     message = b'We have a secret to tell you: hello world.'
     key =     b'secret'
@@ -1,6 +1,16 @@
 from itertools import cycle
 import random
 
+# Native cores (cpp/python/native_module.cpp), used when built. The other
+# modules take _native from here.
+try:
+    from . import _native
+except ImportError:
+    try:
+        import _native
+    except ImportError:
+        _native = None
+
 def sieve_of_eratosthenes(limit):
     """
     Generates prime numbers up to a specified limit using the Sieve of Eratosthenes.
@@ -24,6 +34,12 @@ def sieve_of_eratosthenes(limit):
     return prime_numbers
 
 def xor_bytes(byte_str1, byte_str2):
+     if _native is not None:
+         try:
+             # Buffers are read in place; anything else takes the bytes() path below
+             return _native.xor_bytes(byte_str1, byte_str2)
+         except TypeError:
+             pass
      byte_str1, byte_str2 = bytes(byte_str1), bytes(byte_str2)
      # Simplest concept of DES
      # Requires both strings to be the same length